@@ -399,6 +399,10 @@ private:
     std::cout << "  Peak open set size: " << lastStats.peakOpenSize << std::endl;
     std::cout << "  Peak closed set size: " << lastStats.peakClosedSize << std::endl;
     std::cout << "  Elapsed time: " << lastStats.elapsedMs << " ms" << std::endl;
+    std::cout << "  Deadlock patterns learned: " << lastStats.patternsLearned << std::endl;
+    std::cout << "  Pattern hits: " << lastStats.patternHits << " / " << lastStats.patternLookups
+              << " lookups (" << std::fixed << std::setprecision(1) << lastStats.patternPruneRatio() * 100.0
+              << "% pruned)" << std::endl;
     std::cout << "  Solution found: " << (hasSolution ? "YES" : "NO") << std::endl;
 
     if (hasSolution)
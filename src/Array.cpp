@@ -130,6 +130,8 @@ template class Array<short>;
 template class Array<Cell>;
 template class Array<Door>;
 template class Array<uint64_t>;
+template class Array<uint8_t>;   // For packed search states
+template class Array<uint8_t *>; // For PackedStatePool chunks
 template class Array<Array<int>>;  // For 2D arrays in PlayerPathfinder
 template class Array<Array<char>>; // For 2D arrays in PlayerPathfinder
 
@@ -142,10 +144,8 @@ template class Array<State>;
 template class Array<bool>;          // For corner detection and goal lookup
 template class Array<const State *>; // For path reconstruction
 
-// Include AStarNode definition and instantiate after other templates
-#include "SolverAStar.h"
-template class Array<AStarNode>; // For BinaryHeap implementation
-
-// Additional template instantiations for simulation
-template class Array<Array<char> *>; // For path reconstruction
-template class Array<AStarNode *>;   // For node storage in solver
\ No newline at end of file
+// Include OpenEntry definition and instantiate after other templates
+#include "OpenList.h"
+template class Array<OpenEntry>;   // For BinaryHeap implementation
+template class Array<FBucket>;     // For BucketOpenList f buckets
+template class Array<BucketSlot>;  // For BucketOpenList entry pool
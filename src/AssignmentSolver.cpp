@@ -0,0 +1,186 @@
+#include "AssignmentSolver.h"
+#include <climits>
+
+// Grow an array to at least n elements (new elements are 0)
+static void ensureSize(Array<int> &a, int n)
+{
+  while (a.getSize() < n)
+  {
+    a.push_back(0);
+  }
+}
+
+// Copy the first n elements of src into dst, growing dst if needed
+static void copyPrefix(Array<int> &dst, const Array<int> &src, int n)
+{
+  ensureSize(dst, n);
+  for (int i = 0; i < n; i++)
+  {
+    dst[i] = src[i];
+  }
+}
+
+// Constructor
+AssignmentSolver::AssignmentSolver() : lastRows(0), lastCols(0), baseRows(-1), baseCols(-1)
+{
+}
+
+// Make every working array large enough for an n x m problem
+void AssignmentSolver::reserve(int n, int m)
+{
+  ensureSize(rowPotential, n + 1);
+  ensureSize(colPotential, m + 1);
+  ensureSize(colOwner, m + 1);
+  ensureSize(way, m + 1);
+  ensureSize(minSlack, m + 1);
+  ensureSize(rowMatch, n);
+  while (visited.getSize() < m + 1)
+  {
+    visited.push_back(0);
+  }
+}
+
+// Insert one unmatched row (1-based): grow a shortest-path tree over the
+// columns in reduced costs (cost - u - v) until a free column is reached,
+// then flip the matching along that path. Potentials keep every reduced
+// cost non-negative, so the pass is a plain Dijkstra sweep.
+void AssignmentSolver::augment(const int *cost, int m, int row)
+{
+  // Column 0 is a virtual column holding the row being inserted
+  colOwner[0] = row;
+  int col = 0;
+  for (int j = 0; j <= m; j++)
+  {
+    minSlack[j] = INT_MAX;
+    visited[j] = 0;
+  }
+
+  do
+  {
+    visited[col] = 1;
+    int owner = colOwner[col];
+    const int *rowCost = cost + (owner - 1) * m;
+    int delta = INT_MAX;
+    int next = 0;
+
+    for (int j = 1; j <= m; j++)
+    {
+      if (visited[j])
+        continue;
+      int reduced = rowCost[j - 1] - rowPotential[owner] - colPotential[j];
+      if (reduced < minSlack[j])
+      {
+        minSlack[j] = reduced;
+        way[j] = col;
+      }
+      if (minSlack[j] < delta)
+      {
+        delta = minSlack[j];
+        next = j;
+      }
+    }
+
+    // Shift potentials so the cheapest frontier column becomes tight
+    for (int j = 0; j <= m; j++)
+    {
+      if (visited[j])
+      {
+        rowPotential[colOwner[j]] += delta;
+        colPotential[j] -= delta;
+      }
+      else
+      {
+        minSlack[j] -= delta;
+      }
+    }
+    col = next;
+  } while (colOwner[col] != 0);
+
+  // Walk the path back, shifting each row one column along
+  do
+  {
+    int prev = way[col];
+    colOwner[col] = colOwner[prev];
+    col = prev;
+  } while (col != 0);
+}
+
+// Record rowMatch from the matching and return its total cost
+int AssignmentSolver::matchedCost(const int *cost, int m)
+{
+  int total = 0;
+  for (int j = 1; j <= m; j++)
+  {
+    if (colOwner[j] != 0)
+    {
+      rowMatch[colOwner[j] - 1] = j - 1;
+      total += cost[(colOwner[j] - 1) * m + (j - 1)];
+    }
+  }
+  return total;
+}
+
+// Add rows one at a time, each with one augmentation
+int AssignmentSolver::solve(const int *cost, int n, int m)
+{
+  lastRows = n;
+  lastCols = m;
+  if (n == 0)
+    return 0;
+
+  reserve(n, m);
+  for (int i = 0; i <= n; i++)
+  {
+    rowPotential[i] = 0;
+  }
+  for (int j = 0; j <= m; j++)
+  {
+    colPotential[j] = 0;
+    colOwner[j] = 0;
+  }
+
+  for (int i = 1; i <= n; i++)
+  {
+    augment(cost, m, i);
+  }
+  return matchedCost(cost, m);
+}
+
+// Keep the last solve's solution as the base for solveChangedRow
+void AssignmentSolver::keepAsBase()
+{
+  int n = lastRows;
+  int m = lastCols;
+  copyPrefix(baseRowPotential, rowPotential, n + 1);
+  copyPrefix(baseColPotential, colPotential, m + 1);
+  copyPrefix(baseColOwner, colOwner, m + 1);
+  baseRows = n;
+  baseCols = m;
+}
+
+// Square matrix with one changed row: drop that row from the base matching,
+// lower its potential until all its reduced costs are non-negative again,
+// and re-insert it with one augmentation. The other rows' potentials and
+// matched edges are untouched, so the result is optimal.
+int AssignmentSolver::solveChangedRow(const int *cost, int n, int row)
+{
+  copyPrefix(rowPotential, baseRowPotential, n + 1);
+  copyPrefix(colPotential, baseColPotential, n + 1);
+  copyPrefix(colOwner, baseColOwner, n + 1);
+
+  const int *rowCost = cost + row * n;
+  int u = INT_MAX;
+  for (int j = 1; j <= n; j++)
+  {
+    if (colOwner[j] == row + 1)
+      colOwner[j] = 0;
+    if (rowCost[j - 1] - colPotential[j] < u)
+      u = rowCost[j - 1] - colPotential[j];
+  }
+  rowPotential[row + 1] = u;
+
+  lastRows = n;
+  lastCols = n;
+  augment(cost, n, row + 1);
+  return matchedCost(cost, n);
+}
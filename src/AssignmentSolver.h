@@ -0,0 +1,56 @@
+#pragma once
+#include "Array.h"
+
+// Minimum-cost assignment of n rows to distinct columns (n <= m) with the
+// Hungarian method in its shortest-augmenting-path form (Kuhn-Munkres with
+// row/column potentials, as in Jonker-Volgenant): one Dijkstra-like pass per
+// row, O(n^2 m) overall.
+// Costs are read from a flat row-major n x m buffer. Working arrays are
+// kept between calls and only grow, so repeated solves do not allocate.
+//
+// A solution can be kept as a base; a square matrix differing from the
+// base's in one row is then re-solved with a single augmentation, O(n^2)
+// instead of O(n^3).
+class AssignmentSolver
+{
+private:
+  Array<int> rowPotential; // u[1..n]
+  Array<int> colPotential; // v[0..m]
+  Array<int> colOwner;     // Row (1-based) matched to each column, 0 = free
+  Array<int> way;          // Previous column on the augmenting path
+  Array<int> minSlack;     // Smallest reduced cost reaching each column
+  Array<char> visited;     // Column already on the shortest-path tree
+  Array<int> rowMatch;     // Column (0-based) matched to each row
+  int lastRows;            // Size of the last solved problem
+  int lastCols;
+
+  // Kept solution (potentials and matching) for solveChangedRow
+  Array<int> baseRowPotential;
+  Array<int> baseColPotential;
+  Array<int> baseColOwner;
+  int baseRows;
+  int baseCols;
+
+  void reserve(int n, int m);
+  void augment(const int *cost, int m, int row);
+  int matchedCost(const int *cost, int m);
+
+public:
+  // Constructor
+  AssignmentSolver();
+
+  // Minimum total cost; cost[i * m + j] is the cost of row i in column j.
+  // Entries must be non-negative and small enough that n of them fit an int.
+  int solve(const int *cost, int n, int m);
+
+  // Column chosen for a row by the last solve
+  int getAssignedColumn(int row) const { return rowMatch[row]; }
+
+  // Keep the last solve's solution as the base for solveChangedRow
+  void keepAsBase();
+  bool hasBase(int n, int m) const { return baseRows == n && baseCols == m; }
+
+  // Minimum total cost for a square n x n matrix equal to the base's
+  // except in row `row`. Requires hasBase(n, n); the base is left intact.
+  int solveChangedRow(const int *cost, int n, int row);
+};
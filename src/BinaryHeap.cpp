@@ -154,6 +154,6 @@ template class BinaryHeap<char>;
 template class BinaryHeap<long>;
 template class BinaryHeap<short>;
 
-// Include AStarNode definition and instantiate
-#include "SolverAStar.h"
-template class BinaryHeap<AStarNode>;
\ No newline at end of file
+// Include OpenEntry definition and instantiate
+#include "OpenList.h"
+template class BinaryHeap<OpenEntry>;
\ No newline at end of file
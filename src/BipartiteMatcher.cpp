@@ -0,0 +1,115 @@
+#include "BipartiteMatcher.h"
+
+// Grow an array to at least n elements (new elements are 0)
+static void ensureSize(Array<int> &a, int n)
+{
+  while (a.getSize() < n)
+  {
+    a.push_back(0);
+  }
+}
+
+// Constructor
+BipartiteMatcher::BipartiteMatcher()
+{
+}
+
+// Make every working array large enough for an n x m problem
+void BipartiteMatcher::reserve(int n, int m)
+{
+  ensureSize(rowMatch, n);
+  ensureSize(colMatch, m);
+  ensureSize(layer, n);
+  ensureSize(queue, n);
+}
+
+// Layer the rows by alternating-path length from the free rows. True if
+// some free column is reachable, i.e. an augmenting path exists.
+bool BipartiteMatcher::buildLayers(const int *cost, int n, int m, int noEdge)
+{
+  int head = 0;
+  int tail = 0;
+  for (int i = 0; i < n; i++)
+  {
+    if (rowMatch[i] < 0)
+    {
+      layer[i] = 0;
+      queue[tail++] = i;
+    }
+    else
+    {
+      layer[i] = -1;
+    }
+  }
+
+  bool found = false;
+  while (head < tail)
+  {
+    int row = queue[head++];
+    const int *rowCost = cost + row * m;
+    for (int j = 0; j < m; j++)
+    {
+      if (rowCost[j] >= noEdge)
+        continue;
+      int owner = colMatch[j];
+      if (owner < 0)
+      {
+        found = true;
+      }
+      else if (layer[owner] < 0)
+      {
+        layer[owner] = layer[row] + 1;
+        queue[tail++] = owner;
+      }
+    }
+  }
+  return found;
+}
+
+// Depth-first augment from row along the layers; rows that fail are taken
+// out of the layering so later searches in the phase skip them
+bool BipartiteMatcher::augment(const int *cost, int m, int noEdge, int row)
+{
+  const int *rowCost = cost + row * m;
+  for (int j = 0; j < m; j++)
+  {
+    if (rowCost[j] >= noEdge)
+      continue;
+    int owner = colMatch[j];
+    if (owner < 0 || (layer[owner] == layer[row] + 1 && augment(cost, m, noEdge, owner)))
+    {
+      rowMatch[row] = j;
+      colMatch[j] = row;
+      return true;
+    }
+  }
+  layer[row] = -1;
+  return false;
+}
+
+int BipartiteMatcher::solve(const int *cost, int n, int m, int noEdge)
+{
+  if (n <= 0 || m <= 0)
+    return 0;
+
+  reserve(n, m);
+  for (int i = 0; i < n; i++)
+  {
+    rowMatch[i] = -1;
+  }
+  for (int j = 0; j < m; j++)
+  {
+    colMatch[j] = -1;
+  }
+
+  int matched = 0;
+  while (buildLayers(cost, n, m, noEdge))
+  {
+    for (int i = 0; i < n; i++)
+    {
+      if (rowMatch[i] < 0 && augment(cost, m, noEdge, i))
+        matched++;
+    }
+  }
+  return matched;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "Array.h"
+
+// Maximum bipartite matching of n rows to m columns with Hopcroft-Karp:
+// a BFS layers the rows by shortest alternating path from the free rows,
+// then DFS augments along vertex-disjoint shortest paths, O(E sqrt(V)).
+// Edges are read from a flat row-major n x m cost buffer: row i and
+// column j are joined when cost[i * m + j] < noEdge. Working arrays are
+// kept between calls and only grow, so repeated solves do not allocate.
+class BipartiteMatcher
+{
+private:
+  Array<int> rowMatch; // Column matched to each row, -1 = free
+  Array<int> colMatch; // Row matched to each column, -1 = free
+  Array<int> layer;    // BFS layer per row, -1 = not on a shortest path
+  Array<int> queue;    // BFS queue of rows
+
+  void reserve(int n, int m);
+  bool buildLayers(const int *cost, int n, int m, int noEdge);
+  bool augment(const int *cost, int m, int noEdge, int row);
+
+public:
+  // Constructor
+  BipartiteMatcher();
+
+  // Size of a maximum matching
+  int solve(const int *cost, int n, int m, int noEdge);
+
+  // Column matched to a row by the last solve, -1 if unmatched
+  int getMatchedColumn(int row) const { return rowMatch[row]; }
+};
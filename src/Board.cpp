@@ -8,6 +8,10 @@ Board::Board()
   height = 0;
   time_modulo_L = 1; // Default to 1 if no doors
   // cells and targetPositions default-construct
+
+  // No doors yet: only id 0 (no door) is open
+  Array<Door> noDoors;
+  buildDoorSchedule(noDoors);
 }
 
 bool Board::initialize(int w, int h)
@@ -20,6 +24,7 @@ bool Board::initialize(int w, int h)
   // Reinitialize arrays (assignment to a new Array uses your assignment operator)
   cells = Array<Cell>();
   targetPositions = Array<int>();
+  cellDoorIds = Array<uint8_t>();
 
   int total = width * height;
   // Fill the cells array with default-constructed Cell objects
@@ -27,6 +32,7 @@ bool Board::initialize(int w, int h)
   {
     Cell c; // defaults to FLOOR, isTarget=false, doorId=0
     cells.push_back(c);
+    cellDoorIds.push_back(0);
   }
 
   return true;
@@ -71,7 +77,7 @@ bool Board::is_target_idx(int idx) const
 int Board::get_door_id_idx(int idx) const
 {
   assert(idx >= 0 && idx < cells.getSize());
-  return cells[idx].doorId;
+  return cellDoorIds[idx];
 }
 
 void Board::set_wall(int row, int col)
@@ -83,6 +89,7 @@ void Board::set_wall(int row, int col)
   // if it was target before, keep isTarget? Usually wall shouldn't be target
   cells[idx].isTarget = false;
   cells[idx].doorId = 0;
+  cellDoorIds[idx] = 0;
 }
 
 void Board::set_target(int row, int col)
@@ -105,6 +112,7 @@ void Board::set_door(int row, int col, int id)
   int idx = index(row, col);
   cells[idx].type = CELL_FLOOR;
   cells[idx].doorId = id;
+  cellDoorIds[idx] = uint8_t(id);
   cells[idx].debugChar = char('0' + id);
   // do not touch isTarget here (digit on top of a target is unusual but allowed if spec permits)
 }
@@ -162,6 +170,7 @@ void Board::computeTimeModuloL(const Array<Door> &doors)
   if (doors.getSize() == 0)
   {
     time_modulo_L = 1;
+    buildDoorSchedule(doors);
     return;
   }
 
@@ -199,6 +208,35 @@ void Board::computeTimeModuloL(const Array<Door> &doors)
     }
   }
 
+  buildDoorSchedule(doors);
+
   std::cout << "Computed time modulo L = " << time_modulo_L
             << " from " << doors.getSize() << " doors" << std::endl;
 }
+
+// Precompute every door's open/closed state over one full L cycle
+void Board::buildDoorSchedule(const Array<Door> &doors)
+{
+  int L = time_modulo_L;
+  doorSchedule = Array<uint8_t>();
+  for (int i = 0; i < (MAX_DOOR_ID + 1) * L; i++)
+  {
+    // Row 0 (no door) is always open, undefined ids stay closed
+    doorSchedule.push_back(i < L ? 1 : 0);
+  }
+
+  bool defined[MAX_DOOR_ID + 1] = {false};
+  for (int i = 0; i < doors.getSize(); i++)
+  {
+    const Door &door = doors[i];
+    // First definition of an id wins, as with a linear search by id
+    if (door.id < 1 || door.id > MAX_DOOR_ID || defined[door.id])
+      continue;
+    defined[door.id] = true;
+
+    for (int t = 0; t < L; t++)
+    {
+      doorSchedule[door.id * L + t] = door.isOpenAtTime(t) ? 1 : 0;
+    }
+  }
+}
@@ -4,6 +4,7 @@
 #include "Cell.h"
 #include "Door.h"
 #include <cassert>
+#include <cstdint>
 
 class Board
 {
@@ -15,8 +16,15 @@ private:
   Array<int> targetPositions; // indices of targets
   int time_modulo_L;          // LCM of all door cycles
 
+  // Hot-path door lookups, kept outside Cell
+  Array<uint8_t> cellDoorIds;  // door id per cell (0 = no door), mirrors Cell::doorId
+  Array<uint8_t> doorSchedule; // (MAX_DOOR_ID + 1) rows of L open flags, indexed id * L + t
+
   // Constants
   static const int MAX_SAFE_L = 4096;
+  static const int MAX_DOOR_ID = 9;
+
+  void buildDoorSchedule(const Array<Door> &doors);
 
 public:
   Board();
@@ -41,6 +49,11 @@ public:
   bool is_target_idx(int idx) const;
   int get_door_id_idx(int idx) const;
 
+  // Door schedule, valid once computeTimeModuloL has run. step_mod_L must be in [0, L).
+  // Door id 0 (no door) is always open; ids without a Door definition are always closed.
+  inline bool is_door_open(int doorId, int step_mod_L) const { return doorSchedule[doorId * time_modulo_L + step_mod_L] != 0; }
+  inline bool is_open_idx(int idx, int step_mod_L) const { return is_door_open(cellDoorIds[idx], step_mod_L); }
+
   // Mutators
   void set_wall(int row, int col);
   void set_target(int row, int col);
@@ -52,7 +65,7 @@ public:
   // Debug printing (prints static layout only)
   void pretty_print() const;
 
-  // Door cycle support
+  // Door cycle support (also builds the door schedule table)
   void computeTimeModuloL(const Array<Door> &doors);
 
   // Getters
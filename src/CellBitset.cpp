@@ -0,0 +1,105 @@
+#include "CellBitset.h"
+
+// Constructor
+CellBitset::CellBitset() : words(inlineWords), wordCount(INLINE_WORDS)
+{
+  clear();
+}
+
+// Destructor
+CellBitset::~CellBitset()
+{
+  if (words != inlineWords)
+  {
+    delete[] words;
+  }
+}
+
+// Copy constructor
+CellBitset::CellBitset(const CellBitset &other) : words(inlineWords), wordCount(INLINE_WORDS)
+{
+  clear();
+  *this = other;
+}
+
+// Assignment operator
+CellBitset &CellBitset::operator=(const CellBitset &other)
+{
+  if (this != &other)
+  {
+    if (other.wordCount > wordCount)
+    {
+      grow(other.wordCount);
+    }
+    for (int w = 0; w < other.wordCount; w++)
+    {
+      words[w] = other.words[w];
+    }
+    for (int w = other.wordCount; w < wordCount; w++)
+    {
+      words[w] = 0;
+    }
+  }
+  return *this;
+}
+
+// Grow to at least minWords words (new words are clear)
+void CellBitset::grow(int minWords)
+{
+  int newCount = wordCount * 2;
+  while (newCount < minWords)
+  {
+    newCount *= 2;
+  }
+
+  uint64_t *newWords = new uint64_t[newCount];
+  for (int w = 0; w < wordCount; w++)
+  {
+    newWords[w] = words[w];
+  }
+  for (int w = wordCount; w < newCount; w++)
+  {
+    newWords[w] = 0;
+  }
+
+  if (words != inlineWords)
+  {
+    delete[] words;
+  }
+  words = newWords;
+  wordCount = newCount;
+}
+
+// Set one bit, growing the storage if the cell is past the end
+void CellBitset::set(int cell)
+{
+  if (cell < 0)
+    return;
+
+  int w = cell >> 6;
+  if (w >= wordCount)
+  {
+    grow(w + 1);
+  }
+  words[w] |= uint64_t(1) << (cell & 63);
+}
+
+// Clear every bit
+void CellBitset::clear()
+{
+  for (int w = 0; w < wordCount; w++)
+  {
+    words[w] = 0;
+  }
+}
+
+bool CellBitset::intersects(const CellBitset &other) const
+{
+  int common = wordCount < other.wordCount ? wordCount : other.wordCount;
+  for (int w = 0; w < common; w++)
+  {
+    if (words[w] & other.words[w])
+      return true;
+  }
+  return false;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+
+// Bitset over board cell indices (row * width + col).
+// Boards up to 256 cells fit in inline storage, so copying a small bitset
+// never allocates; larger boards grow onto the heap on demand. Cells past
+// the current size read as clear.
+class CellBitset
+{
+private:
+  static const int INLINE_WORDS = 4;
+
+  uint64_t inlineWords[INLINE_WORDS];
+  uint64_t *words; // inlineWords, or a heap array when wordCount > INLINE_WORDS
+  int wordCount;
+
+  void grow(int minWords);
+
+public:
+  // Constructor
+  CellBitset();
+
+  // Destructor
+  ~CellBitset();
+
+  // Copy constructor and assignment operator
+  CellBitset(const CellBitset &other);
+  CellBitset &operator=(const CellBitset &other);
+
+  // Single-bit operations - O(1)
+  bool test(int cell) const
+  {
+    int w = cell >> 6;
+    return cell >= 0 && w < wordCount && ((words[w] >> (cell & 63)) & 1u);
+  }
+  void set(int cell);
+  void reset(int cell)
+  {
+    int w = cell >> 6;
+    if (cell >= 0 && w < wordCount)
+      words[w] &= ~(uint64_t(1) << (cell & 63));
+  }
+
+  // Clear every bit (keeps storage)
+  void clear();
+
+  // True if any cell is set in both bitsets - O(words)
+  bool intersects(const CellBitset &other) const;
+
+  // Raw word access for bit-parallel scans
+  int getWordCount() const { return wordCount; }
+  uint64_t getWord(int w) const { return w < wordCount ? words[w] : 0; }
+};
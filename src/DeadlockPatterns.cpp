@@ -0,0 +1,382 @@
+#include "DeadlockPatterns.h"
+
+// Direction vectors: up, down, left, right
+static const int dr[] = {-1, 1, 0, 0};
+static const int dc[] = {0, 0, -1, 1};
+
+static int bitCount(uint32_t mask)
+{
+  int count = 0;
+  for (; mask != 0; mask &= mask - 1)
+  {
+    count++;
+  }
+  return count;
+}
+
+// Spread the key bits so neighbouring keys land in different slots
+static uint64_t mixKey(uint64_t key)
+{
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  return key;
+}
+
+void DeadlockPatterns::KeySet::clear()
+{
+  for (int i = 0; i < slots.getSize(); i++)
+  {
+    slots[i] = 0;
+  }
+  size = 0;
+}
+
+bool DeadlockPatterns::KeySet::contains(uint64_t key) const
+{
+  int capacity = slots.getSize();
+  if (capacity == 0)
+    return false;
+  for (int i = int(mixKey(key) & uint64_t(capacity - 1));; i = (i + 1) & (capacity - 1))
+  {
+    if (slots[i] == key)
+      return true;
+    if (slots[i] == 0)
+      return false;
+  }
+}
+
+bool DeadlockPatterns::KeySet::insert(uint64_t key)
+{
+  if (contains(key))
+    return false;
+
+  // Grow past a load factor of 3/4, rehashing every key
+  if ((size + 1) * 4 > slots.getSize() * 3)
+  {
+    Array<uint64_t> old = slots;
+    int capacity = old.getSize() == 0 ? 64 : old.getSize() * 2;
+    slots = Array<uint64_t>();
+    for (int i = 0; i < capacity; i++)
+    {
+      slots.push_back(0);
+    }
+    size = 0;
+    for (int i = 0; i < old.getSize(); i++)
+    {
+      if (old[i] != 0)
+        insert(old[i]);
+    }
+  }
+
+  int capacity = slots.getSize();
+  int i = int(mixKey(key) & uint64_t(capacity - 1));
+  while (slots[i] != 0)
+  {
+    i = (i + 1) & (capacity - 1);
+  }
+  slots[i] = key;
+  size++;
+  return true;
+}
+
+// Constructor
+DeadlockPatterns::DeadlockPatterns()
+    : board(nullptr), deadSquares(nullptr), lookups(0), hits(0), proofs(0), fillStamp(0)
+{
+}
+
+void DeadlockPatterns::initialize(const Board &b, const CellBitset &deadSquaresMap)
+{
+  board = &b;
+  deadSquares = &deadSquaresMap;
+
+  int board_size = board->get_width() * board->get_height();
+  floor = Array<uint8_t>();
+  mark = Array<int>();
+  fillQueue = Array<int>();
+  for (int pos = 0; pos < board_size; pos++)
+  {
+    bool open = false;
+    for (int t = 0; t < board->getTimeModuloL() && !open && !board->is_wall_idx(pos); t++)
+    {
+      open = board->is_open_idx(pos, t);
+    }
+    floor.push_back(open ? 1 : 0);
+    mark.push_back(0);
+    fillQueue.push_back(0);
+  }
+  fillStamp = 0;
+
+  clear();
+}
+
+void DeadlockPatterns::clear()
+{
+  dead.clear();
+  alive.clear();
+  anchorsInUse.clear();
+  resetCounters();
+}
+
+void DeadlockPatterns::resetCounters()
+{
+  lookups = 0;
+  hits = 0;
+  proofs = 0;
+}
+
+int DeadlockPatterns::anchorId(int anchorRow, int anchorCol) const
+{
+  // Blocks holding a cell start at most two rows/columns before the board
+  return (anchorRow + 2) * (board->get_width() + 2) + anchorCol + 2;
+}
+
+uint64_t DeadlockPatterns::key(int anchorRow, int anchorCol, uint32_t mask) const
+{
+  return (uint64_t(anchorId(anchorRow, anchorCol) + 1) << 16) | mask;
+}
+
+int DeadlockPatterns::windowCell(int anchorRow, int anchorCol, int bit) const
+{
+  int row = anchorRow + bit / WINDOW;
+  int col = anchorCol + bit % WINDOW;
+  if (!board->in_bounds(row, col))
+    return -1;
+  return board->index(row, col);
+}
+
+uint32_t DeadlockPatterns::windowMask(const CellBitset &boxes, int anchorRow, int anchorCol) const
+{
+  uint32_t mask = 0;
+  for (int bit = 0; bit < WINDOW * WINDOW; bit++)
+  {
+    int cell = windowCell(anchorRow, anchorCol, bit);
+    if (cell >= 0 && boxes.test(cell))
+      mask |= uint32_t(1) << bit;
+  }
+  return mask;
+}
+
+bool DeadlockPatterns::matches(const CellBitset &boxes, int pos) const
+{
+  if (!board || dead.size == 0)
+    return false;
+
+  lookups++;
+  int row = board->row_of(pos);
+  int col = board->col_of(pos);
+
+  // Every block with pos in its middle 2x2 cells
+  for (int anchorRow = row - 2; anchorRow <= row - 1; anchorRow++)
+  {
+    for (int anchorCol = col - 2; anchorCol <= col - 1; anchorCol++)
+    {
+      if (!anchorsInUse.test(anchorId(anchorRow, anchorCol)))
+        continue;
+
+      uint32_t mask = windowMask(boxes, anchorRow, anchorCol);
+      uint32_t posBit = uint32_t(1) << ((row - anchorRow) * WINDOW + col - anchorCol);
+      for (uint32_t sub = mask;; sub = (sub - 1) & mask)
+      {
+        if ((sub & posBit) && bitCount(sub) <= MAX_PATTERN_BOXES && dead.contains(key(anchorRow, anchorCol, sub)))
+        {
+          hits++;
+          return true;
+        }
+        if (sub == 0)
+          break;
+      }
+    }
+  }
+  return false;
+}
+
+bool DeadlockPatterns::learn(const CellBitset &boxes, int pos)
+{
+  if (!board)
+    return false;
+
+  int row = board->row_of(pos);
+  int col = board->col_of(pos);
+  bool stored = false;
+
+  for (int anchorRow = row - 2; anchorRow <= row - 1; anchorRow++)
+  {
+    for (int anchorCol = col - 2; anchorCol <= col - 1; anchorCol++)
+    {
+      uint32_t mask = windowMask(boxes, anchorRow, anchorCol);
+      uint32_t posBit = uint32_t(1) << ((row - anchorRow) * WINDOW + col - anchorCol);
+      uint64_t k = key(anchorRow, anchorCol, mask);
+      if (bitCount(mask) > MAX_PATTERN_BOXES || dead.contains(k) || alive.contains(k))
+        continue;
+      if (!prove(anchorRow, anchorCol, mask))
+      {
+        alive.insert(k);
+        continue;
+      }
+
+      // Drop the boxes the proof does not need, keeping the pushed one
+      for (int bit = 0; bit < WINDOW * WINDOW; bit++)
+      {
+        uint32_t b = uint32_t(1) << bit;
+        if ((mask & b) && b != posBit && prove(anchorRow, anchorCol, mask & ~b))
+          mask &= ~b;
+      }
+
+      dead.insert(key(anchorRow, anchorCol, mask));
+      anchorsInUse.set(anchorId(anchorRow, anchorCol));
+      stored = true;
+    }
+  }
+  return stored;
+}
+
+// Flood the player's area from start around the block's boxes; returns
+// the area's smallest cell. Reached cells carry the new fillStamp.
+int DeadlockPatterns::fillFrom(int start, int anchorRow, int anchorCol, uint32_t mask)
+{
+  int width = board->get_width();
+  fillStamp++;
+  mark[start] = fillStamp;
+  int head = 0;
+  int tail = 0;
+  int smallest = start;
+  fillQueue[tail++] = start;
+
+  while (head < tail)
+  {
+    int current = fillQueue[head++];
+    int row = current / width;
+    int col = current % width;
+    for (int d = 0; d < 4; d++)
+    {
+      int r = row + dr[d];
+      int c = col + dc[d];
+      if (!board->in_bounds(r, c))
+        continue;
+      int next = r * width + c;
+      if (!floor[next] || mark[next] == fillStamp)
+        continue;
+      int localRow = r - anchorRow;
+      int localCol = c - anchorCol;
+      bool inWindow = localRow >= 0 && localRow < WINDOW && localCol >= 0 && localCol < WINDOW;
+      if (inWindow && (mask >> (localRow * WINDOW + localCol)) & 1u)
+        continue;
+      mark[next] = fillStamp;
+      fillQueue[tail++] = next;
+      if (next < smallest)
+        smallest = next;
+    }
+  }
+  return smallest;
+}
+
+// Exhaust every placement of the block's boxes reachable by pushes, from
+// every player area. Dead if none puts all of them on goals and none
+// pushes a box out of the block within the budget.
+bool DeadlockPatterns::prove(int anchorRow, int anchorCol, uint32_t mask)
+{
+  proofs++;
+  int width = board->get_width();
+  int board_size = width * board->get_height();
+  uint32_t all = (uint32_t(1) << (WINDOW * WINDOW)) - 1;
+
+  // Boxes already on goals are solved here
+  bool onGoals = true;
+  for (int bit = 0; bit < WINDOW * WINDOW && onGoals; bit++)
+  {
+    if ((mask >> bit) & 1u)
+      onGoals = board->is_target_idx(windowCell(anchorRow, anchorCol, bit));
+  }
+  if (onGoals)
+    return false;
+
+  // One start per player area
+  seen.clear();
+  int top = 0;
+  int base = fillStamp;
+  for (int pos = 0; pos < board_size; pos++)
+  {
+    int localRow = pos / width - anchorRow;
+    int localCol = pos % width - anchorCol;
+    bool inWindow = localRow >= 0 && localRow < WINDOW && localCol >= 0 && localCol < WINDOW;
+    if (!floor[pos] || mark[pos] > base || (inWindow && ((mask >> (localRow * WINDOW + localCol)) & 1u)))
+      continue;
+    uint32_t state = (uint32_t(fillFrom(pos, anchorRow, anchorCol, mask)) << 16) | mask;
+    seen.insert(uint64_t(state) + 1);
+    while (stack.getSize() <= top)
+    {
+      stack.push_back(0);
+    }
+    stack[top++] = state;
+  }
+
+  uint32_t nextStates[WINDOW * WINDOW * 4];
+  int nextPlayer[WINDOW * WINDOW * 4];
+  while (top > 0)
+  {
+    uint32_t state = uint32_t(stack[--top]);
+    uint32_t boxes = state & all;
+    fillFrom(state >> 16, anchorRow, anchorCol, boxes);
+
+    int count = 0;
+    for (int bit = 0; bit < WINDOW * WINDOW; bit++)
+    {
+      if (!((boxes >> bit) & 1u))
+        continue;
+      int boxRow = anchorRow + bit / WINDOW;
+      int boxCol = anchorCol + bit % WINDOW;
+      for (int d = 0; d < 4; d++)
+      {
+        int fromRow = boxRow - dr[d];
+        int fromCol = boxCol - dc[d];
+        int destRow = boxRow + dr[d];
+        int destCol = boxCol + dc[d];
+        if (!board->in_bounds(fromRow, fromCol) || !board->in_bounds(destRow, destCol))
+          continue;
+        int dest = board->index(destRow, destCol);
+        if (mark[board->index(fromRow, fromCol)] != fillStamp || !floor[dest])
+          continue;
+
+        // A box leaving the block may still reach a goal
+        int localRow = destRow - anchorRow;
+        int localCol = destCol - anchorCol;
+        if (localRow < 0 || localRow >= WINDOW || localCol < 0 || localCol >= WINDOW)
+          return false;
+        uint32_t destBit = uint32_t(1) << (localRow * WINDOW + localCol);
+        if ((boxes & destBit) || deadSquares->test(dest))
+          continue;
+
+        nextStates[count] = (boxes & ~(uint32_t(1) << bit)) | destBit;
+        nextPlayer[count] = board->index(boxRow, boxCol);
+        count++;
+      }
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+      uint32_t next = nextStates[i];
+      bool solved = true;
+      for (int bit = 0; bit < WINDOW * WINDOW && solved; bit++)
+      {
+        if ((next >> bit) & 1u)
+          solved = board->is_target_idx(windowCell(anchorRow, anchorCol, bit));
+      }
+      if (solved)
+        return false;
+
+      uint32_t child = (uint32_t(fillFrom(nextPlayer[i], anchorRow, anchorCol, next)) << 16) | next;
+      if (!seen.insert(uint64_t(child) + 1))
+        continue;
+      if (seen.size > MAX_PROOF_STATES)
+        return false; // Out of budget: not proven
+      while (stack.getSize() <= top)
+      {
+        stack.push_back(0);
+      }
+      stack[top++] = child;
+    }
+  }
+  return true;
+}
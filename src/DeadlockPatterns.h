@@ -0,0 +1,93 @@
+#pragma once
+#include "Array.h"
+#include "Board.h"
+#include "CellBitset.h"
+#include <cstdint>
+
+// Deadlock patterns learned during search, for one board.
+// A pattern is a set of boxes inside a WINDOW x WINDOW block of cells,
+// proven dead by a small local search: with only those boxes on the board
+// (doors open whenever they ever open, locks ignored) and the player
+// starting anywhere, they can never all stand on goals and none can be
+// pushed out of the block. Removing boxes only adds moves, so any state
+// holding at least the pattern's boxes is dead too.
+//
+// Keys are the block's position plus a box bitmask, kept in an
+// open-addressing set. The board is fixed, so the position stands for the
+// block's walls and goals.
+class DeadlockPatterns
+{
+public:
+  static const int WINDOW = 4;            // Block side in cells
+  static const int MAX_PATTERN_BOXES = 4; // Larger box sets are not tried
+  static const int MAX_PROOF_STATES = 4096; // Local search budget per proof
+
+private:
+  // Open-addressing set of 64-bit keys (0 is the empty slot)
+  struct KeySet
+  {
+    Array<uint64_t> slots; // Power-of-two size
+    int size;
+
+    KeySet() : size(0) {}
+    void clear();
+    bool contains(uint64_t key) const;
+    bool insert(uint64_t key); // False if already present
+  };
+
+  const Board *board;
+  const CellBitset *deadSquares; // Pushes onto these never lead to a goal
+  Array<uint8_t> floor;          // Not a wall, and open in some time slot
+
+  KeySet dead;           // Proven dead (anchor, mask)
+  KeySet alive;          // Proofs that failed, not retried
+  CellBitset anchorsInUse; // Anchors with at least one dead pattern
+
+  // Counters
+  mutable long long lookups; // matches() calls with patterns stored
+  mutable long long hits;    // Of those, states found dead
+  long long proofs;          // Local searches run
+
+  // Local search scratch
+  KeySet seen;
+  Array<uint64_t> stack;   // Pending (player cell << 16 | mask) states
+  Array<int> mark;         // Flood fill stamps per cell
+  Array<int> fillQueue;
+  int fillStamp;
+
+  // Block helpers; anchors are the block's top-left cell, possibly off the board
+  int anchorId(int anchorRow, int anchorCol) const;
+  uint64_t key(int anchorRow, int anchorCol, uint32_t mask) const;
+  uint32_t windowMask(const CellBitset &boxes, int anchorRow, int anchorCol) const;
+  int windowCell(int anchorRow, int anchorCol, int bit) const; // -1 off the board
+
+  bool prove(int anchorRow, int anchorCol, uint32_t mask);
+  int fillFrom(int start, int anchorRow, int anchorCol, uint32_t mask); // Smallest cell reached
+
+public:
+  // Constructor
+  DeadlockPatterns();
+
+  // Bind to a board (forgets every pattern)
+  void initialize(const Board &b, const CellBitset &deadSquaresMap);
+
+  // Forget every pattern and counter
+  void clear();
+
+  // Zero the counters, keeping the patterns (they hold for any start)
+  void resetCounters();
+
+  // True if the boxes of some block holding pos contain a dead pattern.
+  // One hash probe per box subset that includes pos.
+  bool matches(const CellBitset &boxes, int pos) const;
+
+  // Try to prove the boxes around pos dead; a proven pattern is shrunk to
+  // the boxes it needs and stored. True if a pattern was stored.
+  bool learn(const CellBitset &boxes, int pos);
+
+  // Counters
+  int getPatternCount() const { return dead.size; }
+  long long getLookups() const { return lookups; }
+  long long getHits() const { return hits; }
+  long long getProofs() const { return proofs; }
+};
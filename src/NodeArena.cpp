@@ -0,0 +1,79 @@
+#include "NodeArena.h"
+#include <new>
+
+template <typename T>
+const uint32_t NodeArena<T>::NO_NODE;
+
+// Constructor
+template <typename T>
+NodeArena<T>::NodeArena() : chunks(nullptr), chunkCount(0), chunkCapacity(0), count(0)
+{
+}
+
+// Destructor
+template <typename T>
+NodeArena<T>::~NodeArena()
+{
+  clear();
+}
+
+// Grow by one chunk of raw storage (nodes are constructed on allocate)
+template <typename T>
+void NodeArena<T>::addChunk()
+{
+  if (chunkCount >= chunkCapacity)
+  {
+    int newCapacity = chunkCapacity == 0 ? 16 : chunkCapacity * 2;
+    T **newChunks = new T *[newCapacity];
+    for (int i = 0; i < chunkCount; i++)
+    {
+      newChunks[i] = chunks[i];
+    }
+    delete[] chunks;
+    chunks = newChunks;
+    chunkCapacity = newCapacity;
+  }
+
+  chunks[chunkCount] = static_cast<T *>(::operator new(sizeof(T) * CHUNK_SIZE));
+  chunkCount++;
+}
+
+// Construct a new node and return its id - O(1)
+template <typename T>
+uint32_t NodeArena<T>::allocate()
+{
+  if ((count >> CHUNK_BITS) >= static_cast<uint32_t>(chunkCount))
+  {
+    addChunk();
+  }
+
+  uint32_t id = count;
+  new (&chunks[id >> CHUNK_BITS][id & CHUNK_MASK]) T();
+  count++;
+  return id;
+}
+
+// Destroy all nodes and free every chunk
+template <typename T>
+void NodeArena<T>::clear()
+{
+  for (uint32_t id = 0; id < count; id++)
+  {
+    get(id).~T();
+  }
+
+  for (int i = 0; i < chunkCount; i++)
+  {
+    ::operator delete(chunks[i]);
+  }
+  delete[] chunks;
+
+  chunks = nullptr;
+  chunkCount = 0;
+  chunkCapacity = 0;
+  count = 0;
+}
+
+// Include AStarNode definition and instantiate
+#include "SolverAStar.h"
+template class NodeArena<AStarNode>;
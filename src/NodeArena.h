@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+
+// Chunked arena that owns every search node.
+// Nodes are addressed by 32-bit ids and never move once allocated, so
+// references stay valid while the arena grows. The whole arena is released
+// at once with clear(); individual nodes are never freed.
+template <typename T>
+class NodeArena
+{
+private:
+  static const int CHUNK_BITS = 12;
+  static const uint32_t CHUNK_SIZE = 1u << CHUNK_BITS; // nodes per chunk
+  static const uint32_t CHUNK_MASK = CHUNK_SIZE - 1;
+
+  T **chunks;        // chunk table, each chunk holds CHUNK_SIZE nodes
+  int chunkCount;    // chunks currently allocated
+  int chunkCapacity; // size of the chunk table
+  uint32_t count;    // nodes handed out
+
+  void addChunk();
+
+public:
+  static const uint32_t NO_NODE = 0xFFFFFFFFu; // "no parent" / invalid id
+
+  // Constructor
+  NodeArena();
+
+  // Destructor - destroys all nodes and frees all chunks
+  ~NodeArena();
+
+  // The arena owns raw memory, so copying is not allowed
+  NodeArena(const NodeArena &) = delete;
+  NodeArena &operator=(const NodeArena &) = delete;
+
+  // Default-construct a new node and return its id - O(1)
+  uint32_t allocate();
+
+  // Access node by id - O(1)
+  T &get(uint32_t id) { return chunks[id >> CHUNK_BITS][id & CHUNK_MASK]; }
+  const T &get(uint32_t id) const { return chunks[id >> CHUNK_BITS][id & CHUNK_MASK]; }
+
+  // Destroy every node and release all chunks in one shot
+  void clear();
+
+  // Utility methods
+  uint32_t getSize() const { return count; }
+  bool isEmpty() const { return count == 0; }
+};
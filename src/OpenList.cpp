@@ -0,0 +1,118 @@
+#include "OpenList.h"
+
+// Factory for the selected implementation
+OpenList *OpenList::create(OpenListType type)
+{
+  if (type == OPEN_LIST_BUCKET)
+  {
+    return new BucketOpenList();
+  }
+  return new HeapOpenList();
+}
+
+// Constructor
+BucketOpenList::BucketOpenList() : freeSlot(-1), currentF(0), size(0)
+{
+}
+
+// Insert entry - O(1) amortized
+void BucketOpenList::push(const OpenEntry &entry)
+{
+  size++;
+
+  if (entry.f >= MAX_BUCKET_F || entry.f < 0 || entry.h < 0)
+  {
+    overflow.push(entry);
+    return;
+  }
+
+  // Grow the bucket table up to f
+  while (buckets.getSize() <= entry.f)
+  {
+    buckets.push_back(FBucket());
+  }
+
+  FBucket &bucket = buckets[entry.f];
+  while (bucket.hHeads.getSize() <= entry.h)
+  {
+    bucket.hHeads.push_back(-1);
+  }
+
+  // Take a slot from the free list, or grow the pool
+  int slot;
+  if (freeSlot != -1)
+  {
+    slot = freeSlot;
+    freeSlot = pool[slot].next;
+  }
+  else
+  {
+    slot = pool.getSize();
+    pool.push_back(BucketSlot());
+  }
+
+  // Push onto the (f, h) stack
+  pool[slot].entry = entry;
+  pool[slot].next = bucket.hHeads[entry.h];
+  bucket.hHeads[entry.h] = slot;
+
+  if (bucket.count == 0 || entry.h < bucket.minH)
+  {
+    bucket.minH = entry.h;
+  }
+  bucket.count++;
+
+  // An inconsistent heuristic can push below the current cursor
+  if (entry.f < currentF)
+  {
+    currentF = entry.f;
+  }
+}
+
+// Remove and return the (f, h)-smallest entry - O(1) amortized
+OpenEntry BucketOpenList::pop()
+{
+  size--;
+
+  // Advance to the first non-empty f bucket
+  while (currentF < buckets.getSize() && buckets[currentF].count == 0)
+  {
+    currentF++;
+  }
+
+  // Every bucket is empty: the rest lives in the overflow heap
+  if (currentF >= buckets.getSize())
+  {
+    return overflow.pop();
+  }
+
+  // Advance to the first non-empty h stack in this bucket
+  FBucket &bucket = buckets[currentF];
+  while (bucket.hHeads[bucket.minH] == -1)
+  {
+    bucket.minH++;
+  }
+
+  // Pop the top of the stack (LIFO among equal f and h)
+  int slot = bucket.hHeads[bucket.minH];
+  OpenEntry entry = pool[slot].entry;
+  bucket.hHeads[bucket.minH] = pool[slot].next;
+  bucket.count--;
+
+  // Return the slot to the free list
+  pool[slot].next = freeSlot;
+  freeSlot = slot;
+
+  return entry;
+}
+
+// Remove all entries and release bucket storage
+void BucketOpenList::clear()
+{
+  buckets = Array<FBucket>();
+  pool = Array<BucketSlot>();
+  overflow = BinaryHeap<OpenEntry>();
+  freeSlot = -1;
+  currentF = 0;
+  size = 0;
+}
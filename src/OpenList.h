@@ -0,0 +1,124 @@
+#pragma once
+#include "Array.h"
+#include "BinaryHeap.h"
+#include <cstdint>
+
+// Compact open-set entry: ordering keys plus the node's arena id.
+// The heavyweight AStarNode stays in the arena; heap swaps move 12 bytes.
+struct OpenEntry
+{
+  int f;       // Total cost (g + h)
+  int h;       // Heuristic cost, used for tie-breaking
+  uint32_t id; // Node id in the solver's arena
+
+  OpenEntry() : f(0), h(0), id(0) {}
+  OpenEntry(int f_cost, int h_cost, uint32_t nodeId) : f(f_cost), h(h_cost), id(nodeId) {}
+
+  // Comparison for BinaryHeap (min-heap by f, tie-break by h)
+  bool operator<(const OpenEntry &other) const
+  {
+    if (f != other.f)
+    {
+      return f < other.f; // Smaller f has higher priority
+    }
+    return h < other.h; // Tie-break by smaller h
+  }
+
+  bool operator>(const OpenEntry &other) const
+  {
+    return other < *this;
+  }
+
+  bool operator<=(const OpenEntry &other) const
+  {
+    return !(*this > other);
+  }
+
+  bool operator>=(const OpenEntry &other) const
+  {
+    return !(*this < other);
+  }
+};
+
+// Available open-set implementations
+enum OpenListType
+{
+  OPEN_LIST_BINARY_HEAP, // O(log n) push/pop, any cost values
+  OPEN_LIST_BUCKET       // O(1) amortized push/pop for small integer costs
+};
+
+// Common interface for the solver's open set.
+// pop() returns the entry with the smallest f, ties broken by smaller h.
+class OpenList
+{
+public:
+  virtual ~OpenList() {}
+
+  virtual void push(const OpenEntry &entry) = 0;
+  virtual OpenEntry pop() = 0; // Assumes the list is not empty
+  virtual bool isEmpty() const = 0;
+  virtual int getSize() const = 0;
+  virtual void clear() = 0;
+
+  // Factory for the selected implementation (caller owns the result)
+  static OpenList *create(OpenListType type);
+};
+
+// Open list backed by the BinaryHeap min-heap
+class HeapOpenList : public OpenList
+{
+private:
+  BinaryHeap<OpenEntry> heap;
+
+public:
+  void push(const OpenEntry &entry) { heap.push(entry); }
+  OpenEntry pop() { return heap.pop(); }
+  bool isEmpty() const { return heap.isEmpty(); }
+  int getSize() const { return heap.getSize(); }
+  void clear() { heap = BinaryHeap<OpenEntry>(); }
+};
+
+// Slot in the bucket list's entry pool (intrusive singly linked stack)
+struct BucketSlot
+{
+  OpenEntry entry;
+  int next; // Next slot in the same (f, h) stack, or -1
+
+  BucketSlot() : next(-1) {}
+};
+
+// All entries sharing one f value, stacked per h
+struct FBucket
+{
+  Array<int> hHeads; // hHeads[h] = top slot of the h stack, or -1
+  int count;         // Entries in this bucket
+  int minH;          // Lower bound on the smallest non-empty h (valid when count > 0)
+
+  FBucket() : count(0), minH(0) {}
+};
+
+// Two-level bucket queue indexed by f, then h.
+// Entries with equal (f, h) pop in LIFO order. Costs at or above
+// MAX_BUCKET_F (e.g. the 999999 "unreachable" heuristic) go to a
+// BinaryHeap overflow, which always sorts after every bucket.
+class BucketOpenList : public OpenList
+{
+private:
+  static const int MAX_BUCKET_F = 1 << 16;
+
+  Array<FBucket> buckets;          // buckets[f]
+  Array<BucketSlot> pool;          // Entry storage shared by all stacks
+  int freeSlot;                    // Head of the free slot list, or -1
+  int currentF;                    // No bucket below this f holds entries
+  int size;                        // Entries stored (buckets + overflow)
+  BinaryHeap<OpenEntry> overflow;  // Entries with f >= MAX_BUCKET_F
+
+public:
+  BucketOpenList();
+
+  void push(const OpenEntry &entry);
+  OpenEntry pop();
+  bool isEmpty() const { return size == 0; }
+  int getSize() const { return size; }
+  void clear();
+};
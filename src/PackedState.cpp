@@ -0,0 +1,158 @@
+#include "PackedState.h"
+#include <cstring>
+
+// Constructor
+StatePacker::StatePacker()
+    : boxCount(0), lockedCapacity(0), boxOffset(6), lockedOffset(6), keyMaskOffset(6), keySize(6), recordSize(6)
+{
+}
+
+// Derive the layout from the level's initial state
+void StatePacker::initialize(const State &initial, bool normalizedPlayer)
+{
+  boxCount = initial.getBoxCount();
+  lockedCapacity = 0;
+  for (int i = 0; i < boxCount; i++)
+  {
+    if (initial.getBox(i).id != 0)
+    {
+      lockedCapacity++;
+    }
+  }
+
+  keyPositions = Array<int>();
+  keyIds = Array<char>();
+  for (int i = 0; i < initial.getKeyCount(); i++)
+  {
+    keyPositions.push_back(initial.getKeyPos(i));
+    keyIds.push_back(initial.getKeyId(i));
+  }
+
+  boxOffset = 6;
+  lockedOffset = boxOffset + 2 * boxCount;
+  keyMaskOffset = lockedOffset + lockedCapacity;
+  keySize = keyMaskOffset + (keyPositions.getSize() + 7) / 8;
+  recordSize = normalizedPlayer ? keySize + 2 : keySize;
+}
+
+// Encode a canonicalized state into recordSize bytes
+void StatePacker::pack(const State &s, uint8_t *out) const
+{
+  memset(out, 0, recordSize);
+
+  uint16_t player = static_cast<uint16_t>(s.getCanonicalPlayerPos());
+  uint16_t step = static_cast<uint16_t>(s.getStepModL());
+  memcpy(out, &player, 2);
+  memcpy(out + 2, &step, 2);
+  out[4] = static_cast<uint8_t>(static_cast<int8_t>(s.getKeyHeld()));
+
+  // Box positions; locked boxes sort last, so their ids fill the tail
+  int locked = 0;
+  for (int i = 0; i < boxCount; i++)
+  {
+    const BoxInfo &box = s.getBox(i);
+    uint16_t pos = static_cast<uint16_t>(box.pos);
+    memcpy(out + boxOffset + 2 * i, &pos, 2);
+    if (box.id != 0)
+    {
+      out[lockedOffset + locked] = static_cast<uint8_t>(box.id);
+      locked++;
+    }
+  }
+  out[5] = static_cast<uint8_t>(locked);
+
+  // Keys still on board, as bits over the initial key list
+  for (int k = 0; k < s.getKeyCount(); k++)
+  {
+    int keyPos = s.getKeyPos(k);
+    for (int i = 0; i < keyPositions.getSize(); i++)
+    {
+      if (keyPositions[i] == keyPos)
+      {
+        out[keyMaskOffset + (i >> 3)] |= static_cast<uint8_t>(1u << (i & 7));
+        break;
+      }
+    }
+  }
+
+  if (recordSize > keySize)
+  {
+    uint16_t truePlayer = static_cast<uint16_t>(s.getPlayerPos());
+    memcpy(out + keySize, &truePlayer, 2);
+  }
+}
+
+// Decode into a fresh State (energy 0, no parent, hash not computed)
+void StatePacker::unpack(const uint8_t *in, State &out) const
+{
+  uint16_t player;
+  uint16_t step;
+  memcpy(&player, in, 2);
+  memcpy(&step, in + 2, 2);
+  int keyHeld = static_cast<int8_t>(in[4]);
+  int locked = in[5];
+
+  uint16_t truePlayer = player;
+  if (recordSize > keySize)
+  {
+    memcpy(&truePlayer, in + keySize, 2);
+  }
+
+  out = State(truePlayer, keyHeld, 0, step);
+  if (truePlayer != player)
+  {
+    out.setCanonicalPlayerPos(player);
+  }
+
+  int firstLocked = boxCount - locked;
+  for (int i = 0; i < boxCount; i++)
+  {
+    uint16_t pos;
+    memcpy(&pos, in + boxOffset + 2 * i, 2);
+    char id = i >= firstLocked ? static_cast<char>(in[lockedOffset + i - firstLocked]) : 0;
+    out.addBox(pos, id);
+  }
+
+  // Keys come back in initial order, matching removeKey's order-preserving shift
+  for (int i = 0; i < keyPositions.getSize(); i++)
+  {
+    if (in[keyMaskOffset + (i >> 3)] & (1u << (i & 7)))
+    {
+      out.addKey(keyPositions[i], keyIds[i]);
+    }
+  }
+}
+
+// Constructor
+PackedStatePool::PackedStatePool() : recordSize(0), keySize(0), count(0)
+{
+}
+
+// Destructor
+PackedStatePool::~PackedStatePool()
+{
+  reset(0);
+}
+
+// Drop every record and set the record size for the next search
+void PackedStatePool::reset(int bytesPerRecord, int keyBytes)
+{
+  for (int i = 0; i < chunks.getSize(); i++)
+  {
+    delete[] chunks[i];
+  }
+  chunks = Array<uint8_t *>();
+  recordSize = bytesPerRecord;
+  keySize = keyBytes < 0 ? bytesPerRecord : keyBytes;
+  count = 0;
+}
+
+// Reserve a new record and return its id - O(1)
+uint32_t PackedStatePool::allocate()
+{
+  if ((count >> CHUNK_BITS) >= static_cast<uint32_t>(chunks.getSize()))
+  {
+    chunks.push_back(new uint8_t[CHUNK_SIZE * recordSize]);
+  }
+  return count++;
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "Array.h"
+#include "State.h"
+#include <cstdint>
+
+// Compact byte encoding of the search-relevant part of a State.
+// The layout is fixed per level from the initial state (box count, locked
+// boxes, keys), so every record has the same size and equal states have
+// identical bytes - records can be compared with memcmp.
+//
+//   [0..1]  player position   (uint16, the normalized cell if the state has one)
+//   [2..3]  step mod L        (uint16)
+//   [4]     key held          (int8, -1 = none)
+//   [5]     locked box count  (uint8)
+//   [6..]   box positions     (uint16 each, canonical order)
+//   then    locked box ids    (one byte per initially locked box; the
+//                              locked boxes are the last ones in canonical order)
+//   then    keys on board     (bitmask over the initial key list)
+//   then    true player position (uint16, only with normalized players)
+//
+// The bytes before the true player position form the record's key: two
+// records describe the same search state when their keys are equal.
+//
+// Energy, parent and action are not stored: energy is the node's g cost
+// and the search keeps parent links itself. A level with four plain boxes
+// packs into 14 bytes.
+class StatePacker
+{
+private:
+  int boxCount;        // Boxes never appear or disappear during the search
+  int lockedCapacity;  // Labeled boxes in the initial state
+  int boxOffset;       // Byte offset of the box positions
+  int lockedOffset;    // Byte offset of the locked box ids
+  int keyMaskOffset;   // Byte offset of the key bitmask
+  int keySize;         // Bytes compared to identify a state
+  int recordSize;      // Total bytes per packed state
+  Array<int> keyPositions; // Initial keys (bit i of the mask = key i still on board)
+  Array<char> keyIds;
+
+public:
+  // Constructor
+  StatePacker();
+
+  // Derive the layout from the level's initial state. With normalizedPlayer,
+  // records also carry the true player position after the key.
+  void initialize(const State &initial, bool normalizedPlayer = false);
+
+  // Bytes per packed state, and the leading bytes that identify it
+  int getRecordSize() const { return recordSize; }
+  int getKeySize() const { return keySize; }
+
+  // Encode a canonicalized state into recordSize bytes
+  void pack(const State &s, uint8_t *out) const;
+
+  // Decode into a fresh State (energy 0, no parent, hash not computed)
+  void unpack(const uint8_t *in, State &out) const;
+};
+
+// Chunked store of fixed-size packed states addressed by 32-bit ids.
+// Records never move once allocated; the whole store is released at once.
+class PackedStatePool
+{
+private:
+  static const int CHUNK_BITS = 12;
+  static const uint32_t CHUNK_SIZE = 1u << CHUNK_BITS; // records per chunk
+  static const uint32_t CHUNK_MASK = CHUNK_SIZE - 1;
+
+  Array<uint8_t *> chunks; // each chunk holds CHUNK_SIZE records
+  int recordSize;          // bytes per record
+  int keySize;             // leading bytes that identify the state
+  uint32_t count;          // records handed out
+
+public:
+  // Constructor
+  PackedStatePool();
+
+  // Destructor - frees all chunks
+  ~PackedStatePool();
+
+  // The pool owns raw memory, so copying is not allowed
+  PackedStatePool(const PackedStatePool &) = delete;
+  PackedStatePool &operator=(const PackedStatePool &) = delete;
+
+  // Drop every record and set the record (and key) size for the next search;
+  // the key defaults to the whole record
+  void reset(int bytesPerRecord, int keyBytes = -1);
+
+  // Reserve a new record and return its id - O(1)
+  uint32_t allocate();
+
+  // Access record by id - O(1)
+  uint8_t *get(uint32_t id) { return chunks[id >> CHUNK_BITS] + (id & CHUNK_MASK) * recordSize; }
+  const uint8_t *get(uint32_t id) const { return chunks[id >> CHUNK_BITS] + (id & CHUNK_MASK) * recordSize; }
+
+  // Utility methods
+  int getRecordSize() const { return recordSize; }
+  int getKeySize() const { return keySize; }
+  uint32_t getSize() const { return count; }
+};
@@ -0,0 +1,330 @@
+#include "PatternTable.h"
+#include <fstream>
+
+const char *const PatternTable::DEFAULT_PATH = "data/deadlock3x3.bin";
+
+static const char MAGIC[4] = {'S', 'K', 'D', 'T'};
+static const uint8_t VERSION = 1;
+
+// Node standing for every cell outside the block, all connected
+static const int OUTSIDE = PatternTable::CELLS;
+
+// Direction vectors: up, down, left, right
+static const int dr[] = {-1, 1, 0, 0};
+static const int dc[] = {0, 0, -1, 1};
+
+// CELL_STATES ^ i
+static const int power5[PatternTable::CELLS] = {1, 5, 25, 125, 625, 3125, 15625, 78125, 390625};
+
+// Neighbour of a block cell, or OUTSIDE when it leaves the block
+static int stepCell(int cell, int d)
+{
+  int row = cell / PatternTable::WINDOW + dr[d];
+  int col = cell % PatternTable::WINDOW + dc[d];
+  if (row < 0 || row >= PatternTable::WINDOW || col < 0 || col >= PatternTable::WINDOW)
+    return OUTSIDE;
+  return row * PatternTable::WINDOW + col;
+}
+
+// Nodes the player reaches from start around the walls and boxes (bitmask)
+static int reachFrom(int start, int walls, int boxes)
+{
+  int blocked = walls | boxes;
+  int reached = 1 << start;
+  int frontier = reached;
+  while (frontier != 0)
+  {
+    int next = 0;
+    for (int node = 0; node <= OUTSIDE; node++)
+    {
+      if (!((frontier >> node) & 1))
+        continue;
+      if (node == OUTSIDE)
+      {
+        // The outside touches every border cell
+        for (int cell = 0; cell < PatternTable::CELLS; cell++)
+        {
+          int row = cell / PatternTable::WINDOW;
+          int col = cell % PatternTable::WINDOW;
+          if (row == 0 || col == 0 || row == PatternTable::WINDOW - 1 || col == PatternTable::WINDOW - 1)
+            next |= 1 << cell;
+        }
+        continue;
+      }
+      for (int d = 0; d < 4; d++)
+      {
+        next |= 1 << stepCell(node, d);
+      }
+    }
+    frontier = next & ~blocked & ~reached;
+    reached |= frontier;
+  }
+  return reached;
+}
+
+static int lowestBit(int mask)
+{
+  int bit = 0;
+  while (!((mask >> bit) & 1))
+  {
+    bit++;
+  }
+  return bit;
+}
+
+// Constructor
+PatternTable::PatternTable()
+    : maxBoxes(0), deadCount(0), board(nullptr)
+{
+}
+
+int PatternTable::encode(const char *cells)
+{
+  int code = 0;
+  for (int i = 0; i < CELLS; i++)
+  {
+    int value = CELL_FLOOR;
+    switch (cells[i])
+    {
+    case '#':
+      value = CELL_WALL;
+      break;
+    case '.':
+      value = CELL_GOAL;
+      break;
+    case '$':
+      value = CELL_BOX;
+      break;
+    case '*':
+      value = CELL_BOX_ON_GOAL;
+      break;
+    }
+    code += value * power5[i];
+  }
+  return code;
+}
+
+// Search every box placement reachable by pushes from every player area.
+// Dead if none puts all boxes on goals and none pushes a box out.
+bool PatternTable::proveDead(const int *cells)
+{
+  int walls = 0;
+  int goals = 0;
+  int start = 0;
+  for (int i = 0; i < CELLS; i++)
+  {
+    if (cells[i] == CELL_WALL)
+      walls |= 1 << i;
+    if (cells[i] == CELL_GOAL || cells[i] == CELL_BOX_ON_GOAL)
+      goals |= 1 << i;
+    if (cells[i] == CELL_BOX || cells[i] == CELL_BOX_ON_GOAL)
+      start |= 1 << i;
+  }
+  if ((start & ~goals) == 0)
+    return false;
+
+  // States are (boxes << 4 | player area's lowest node); stamps avoid
+  // clearing the visited marks between proofs
+  static int visited[(1 << CELLS) << 4];
+  static int stamp = 0;
+  static int stack[(1 << CELLS) << 4];
+  stamp++;
+  int top = 0;
+
+  int free = ~(walls | start) & ((1 << (OUTSIDE + 1)) - 1);
+  while (free != 0)
+  {
+    int area = reachFrom(lowestBit(free), walls, start);
+    int state = (start << 4) | lowestBit(area);
+    visited[state] = stamp;
+    stack[top++] = state;
+    free &= ~area;
+  }
+
+  while (top > 0)
+  {
+    int state = stack[--top];
+    int boxes = state >> 4;
+    int area = reachFrom(state & 15, walls, boxes);
+
+    for (int box = 0; box < CELLS; box++)
+    {
+      if (!((boxes >> box) & 1))
+        continue;
+      for (int d = 0; d < 4; d++)
+      {
+        int from = stepCell(box, d ^ 1); // Opposite side of the box
+        int dest = stepCell(box, d);
+        if (!((area >> from) & 1))
+          continue;
+        if (dest == OUTSIDE)
+          return false; // Out of the block, it may still reach a goal
+        if (((walls | boxes) >> dest) & 1)
+          continue;
+
+        int next = (boxes & ~(1 << box)) | (1 << dest);
+        if ((next & ~goals) == 0)
+          return false;
+        int child = (next << 4) | lowestBit(reachFrom(box, walls, next));
+        if (visited[child] == stamp)
+          continue;
+        visited[child] = stamp;
+        stack[top++] = child;
+      }
+    }
+  }
+  return true;
+}
+
+void PatternTable::generate(int maxBoxesToProve)
+{
+  bits = Array<uint8_t>();
+  for (int i = 0; i < (CODE_COUNT + 7) / 8; i++)
+  {
+    bits.push_back(0);
+  }
+  maxBoxes = maxBoxesToProve;
+  deadCount = 0;
+
+  // Removing a box lowers the code, so every subset is decided first
+  int cells[CELLS];
+  for (int code = 0; code < CODE_COUNT; code++)
+  {
+    int rest = code;
+    int boxCount = 0;
+    bool dead = false;
+    for (int i = 0; i < CELLS; i++)
+    {
+      cells[i] = rest % CELL_STATES;
+      rest /= CELL_STATES;
+      if (cells[i] == CELL_BOX || cells[i] == CELL_BOX_ON_GOAL)
+      {
+        boxCount++;
+        dead = dead || isDeadCode(code - 2 * power5[i]);
+      }
+    }
+
+    if (!dead && boxCount > 0 && boxCount <= maxBoxes)
+      dead = proveDead(cells);
+    if (dead)
+    {
+      bits[code >> 3] |= uint8_t(1u << (code & 7));
+      deadCount++;
+    }
+  }
+}
+
+bool PatternTable::save(const std::string &path) const
+{
+  std::ofstream file(path.c_str(), std::ios::binary);
+  if (!file)
+    return false;
+
+  char header[8] = {MAGIC[0], MAGIC[1], MAGIC[2], MAGIC[3],
+                    char(VERSION), char(WINDOW), char(CELL_STATES), char(maxBoxes)};
+  file.write(header, sizeof(header));
+  for (int i = 0; i < bits.getSize(); i++)
+  {
+    file.put(char(bits[i]));
+  }
+  return bool(file);
+}
+
+bool PatternTable::load(const std::string &path)
+{
+  bits = Array<uint8_t>();
+  maxBoxes = 0;
+  deadCount = 0;
+
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file)
+    return false;
+
+  char header[8];
+  if (!file.read(header, sizeof(header)) ||
+      header[0] != MAGIC[0] || header[1] != MAGIC[1] || header[2] != MAGIC[2] || header[3] != MAGIC[3] ||
+      header[4] != char(VERSION) || header[5] != char(WINDOW) || header[6] != char(CELL_STATES) || header[7] <= 0)
+    return false;
+
+  // Read everything, then check nothing is missing or left over
+  Array<uint8_t> loaded;
+  int dead = 0;
+  char byte;
+  while (file.get(byte))
+  {
+    loaded.push_back(uint8_t(byte));
+    for (uint8_t b = uint8_t(byte); b != 0; b &= uint8_t(b - 1))
+    {
+      dead++;
+    }
+  }
+  if (loaded.getSize() != (CODE_COUNT + 7) / 8)
+    return false;
+
+  bits = loaded;
+  maxBoxes = header[7];
+  deadCount = dead;
+  return true;
+}
+
+void PatternTable::bind(const Board &b)
+{
+  board = &b;
+  int width = board->get_width();
+  int height = board->get_height();
+
+  anchorCode = Array<int>();
+  for (int anchorRow = -2; anchorRow < height; anchorRow++)
+  {
+    for (int anchorCol = -2; anchorCol < width; anchorCol++)
+    {
+      int code = 0;
+      for (int i = 0; i < CELLS; i++)
+      {
+        int row = anchorRow + i / WINDOW;
+        int col = anchorCol + i % WINDOW;
+        if (!board->in_bounds(row, col) || board->is_wall_idx(board->index(row, col)))
+          continue;
+
+        int cell = board->index(row, col);
+        bool open = false;
+        for (int t = 0; t < board->getTimeModuloL() && !open; t++)
+        {
+          open = board->is_open_idx(cell, t);
+        }
+        if (open)
+          code += (board->is_target_idx(cell) ? CELL_GOAL : CELL_FLOOR) * power5[i];
+      }
+      anchorCode.push_back(code);
+    }
+  }
+}
+
+bool PatternTable::matches(const CellBitset &boxes, int pos) const
+{
+  if (!board || !isLoaded())
+    return false;
+
+  int width = board->get_width();
+  int row = board->row_of(pos);
+  int col = board->col_of(pos);
+
+  // A box adds 2 to its cell's digit (floor to box, goal to box on goal)
+  for (int anchorRow = row - WINDOW + 1; anchorRow <= row; anchorRow++)
+  {
+    for (int anchorCol = col - WINDOW + 1; anchorCol <= col; anchorCol++)
+    {
+      int code = anchorCode[(anchorRow + 2) * (width + 2) + anchorCol + 2];
+      for (int i = 0; i < CELLS; i++)
+      {
+        int r = anchorRow + i / WINDOW;
+        int c = anchorCol + i % WINDOW;
+        if (board->in_bounds(r, c) && boxes.test(board->index(r, c)))
+          code += 2 * power5[i];
+      }
+      if (isDeadCode(code))
+        return true;
+    }
+  }
+  return false;
+}
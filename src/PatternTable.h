@@ -0,0 +1,75 @@
+#pragma once
+#include "Array.h"
+#include "Board.h"
+#include "CellBitset.h"
+#include <cstdint>
+#include <string>
+
+// Deadlock table for every WINDOW x WINDOW block of cells, generated
+// offline and loaded from disk. Each cell of a block is a wall, floor,
+// goal, box or box on a goal; a block's code is those cell values read as
+// a base-5 number (row-major, first cell lowest), and the table keeps one
+// bit per code.
+//
+// A block is dead when a small search proves its boxes can never all
+// stand on its goals and none can be pushed out of it. Everything outside
+// the block is taken as floor the player can walk around, so the proof
+// holds wherever the block appears on a board.
+class PatternTable
+{
+public:
+  static const int WINDOW = 3;
+  static const int CELLS = WINDOW * WINDOW;
+  static const int CELL_STATES = 5;
+  static const int CODE_COUNT = 1953125;   // CELL_STATES ^ CELLS
+  static const int DEFAULT_MAX_BOXES = 4;  // Larger blocks are dead only through a subset
+  static const char *const DEFAULT_PATH;   // Relative to the working directory
+
+  enum CellCode
+  {
+    CELL_WALL = 0,
+    CELL_FLOOR = 1,
+    CELL_GOAL = 2,
+    CELL_BOX = 3,        // Box on floor
+    CELL_BOX_ON_GOAL = 4
+  };
+
+private:
+  Array<uint8_t> bits; // Bit per code, set when dead
+  int maxBoxes;        // Most boxes a proof was run for (0: no table)
+  int deadCount;
+
+  // Bound board: code of every block with its boxes removed
+  const Board *board;
+  Array<int> anchorCode; // By (anchorRow + 2) * (width + 2) + anchorCol + 2
+
+  static bool proveDead(const int *cells);
+
+public:
+  // Constructor
+  PatternTable();
+
+  // Build the table from scratch; deterministic for a given maxBoxes
+  void generate(int maxBoxes);
+
+  // Binary file: "SKDT", version, WINDOW, CELL_STATES, maxBoxes, then the bits
+  bool save(const std::string &path) const;
+  bool load(const std::string &path); // False (table left empty) if missing or malformed
+
+  bool isLoaded() const { return maxBoxes > 0; }
+  int getMaxBoxes() const { return maxBoxes; }
+  int getDeadCount() const { return deadCount; }
+  bool isDeadCode(int code) const { return maxBoxes > 0 && ((bits[code >> 3] >> (code & 7)) & 1u); }
+
+  // Code of a block drawn as CELLS characters, row-major:
+  // '#' wall, ' ' floor, '.' goal, '$' box, '*' box on goal
+  static int encode(const char *cells);
+
+  // Precompute the block codes of a board; cells that are walls, never
+  // open, or off the board count as walls
+  void bind(const Board &b);
+
+  // True if some block holding pos is dead with the given boxes.
+  // One table probe per block.
+  bool matches(const CellBitset &boxes, int pos) const;
+};
@@ -2,7 +2,7 @@
 #include <iostream>
 
 PlayerPathfinder::PlayerPathfinder()
-    : board(nullptr), doors(nullptr)
+    : board(nullptr), doors(nullptr), L(1), tableSize(0), epoch(0), bitParallel(false)
 {
 }
 
@@ -11,82 +11,107 @@ void PlayerPathfinder::initialize(const Board &b, const Array<Door> &d)
   board = &b;
   doors = &d;
   initializeTables();
+  initializeFloorRows();
   // Clear any previously set blocked positions
-  while (blockedPositions.getSize() > 0)
-  {
-    blockedPositions.pop_back();
-  }
+  blockedCells.clear();
 }
 
 void PlayerPathfinder::setBlockedPositions(const Array<int> &blocked)
 {
-  // Clear existing blocked positions
-  while (blockedPositions.getSize() > 0)
-  {
-    blockedPositions.pop_back();
-  }
-  // Copy new blocked positions
+  // Replace existing blocked positions
+  blockedCells.clear();
   for (int i = 0; i < blocked.getSize(); i++)
   {
-    blockedPositions.push_back(blocked[i]);
+    blockedCells.set(blocked[i]);
   }
 }
 
+void PlayerPathfinder::setBlockedCells(const CellBitset &blocked)
+{
+  blockedCells = blocked;
+}
+
 void PlayerPathfinder::initializeTables()
 {
   if (!board)
     return;
 
-  int L = board->getTimeModuloL();
-  int board_size = board->get_width() * board->get_height();
-
-  // Initialize 2D tables
-  dist_table.resize(board_size);
-  parent_pos.resize(board_size);
-  parent_step.resize(board_size);
-  parent_move.resize(board_size);
+  L = board->getTimeModuloL();
+  int size = board->get_width() * board->get_height() * L;
 
-  for (int pos = 0; pos < board_size; pos++)
+  // Allocate once per board size; later searches only bump the epoch
+  if (size != tableSize)
   {
-    dist_table[pos].resize(L);
-    parent_pos[pos].resize(L);
-    parent_step[pos].resize(L);
-    parent_move[pos].resize(L);
-
-    // Initialize all distances to infinity
-    for (int t = 0; t < L; t++)
+    tableSize = size;
+    dist_table = Array<int>();
+    parent_index = Array<int>();
+    parent_move = Array<char>();
+    stamp = Array<int>();
+    bfs_queue = Array<int>();
+    for (int i = 0; i < tableSize; i++)
     {
-      dist_table[pos][t] = INT_MAX;
-      parent_pos[pos][t] = -1;
-      parent_step[pos][t] = -1;
-      parent_move[pos][t] = '\0';
+      dist_table.push_back(INT_MAX);
+      parent_index.push_back(-1);
+      parent_move.push_back('\0');
+      stamp.push_back(0);
+      bfs_queue.push_back(0);
     }
   }
+
+  // Invalidate every entry
+  newEpoch();
 }
 
-bool PlayerPathfinder::isDoorOpen(int pos, int step_mod_L) const
+// Static per-row floor masks used by the bit-parallel flood fill
+void PlayerPathfinder::initializeFloorRows()
 {
-  if (!board)
-    return false;
+  int rows = board->get_height();
+  int cols = board->get_width();
+  bitParallel = (L == 1 && cols <= 64);
 
-  // Get door ID at this position
-  int door_id = board->get_door_id_idx(pos);
-  if (door_id == -1 || door_id == 0) // -1 or 0 means no door
-    return true;                     // No door means it's open
+  floorRows = Array<uint64_t>();
+  openRows = Array<uint64_t>();
+  reachRows = Array<uint64_t>();
+  if (!bitParallel)
+    return;
 
-  // If we have doors array, find door with this ID
-  if (!doors)
-    return false; // Door ID exists but no doors array
+  for (int r = 0; r < rows; r++)
+  {
+    uint64_t bits = 0;
+    for (int c = 0; c < cols; c++)
+    {
+      int pos = r * cols + c;
+      if (!board->is_wall_idx(pos) && board->is_open_idx(pos, 0))
+        bits |= uint64_t(1) << c;
+    }
+    floorRows.push_back(bits);
+    openRows.push_back(0);
+    reachRows.push_back(0);
+  }
+}
 
-  for (int i = 0; i < doors->getSize(); i++)
+// Start a new search: entries stamped with an older epoch read as unvisited
+void PlayerPathfinder::newEpoch()
+{
+  epoch++;
+  if (epoch == INT_MAX)
   {
-    if ((*doors)[i].id == door_id)
+    // Counter wrapped: clear the stamps once
+    for (int i = 0; i < tableSize; i++)
     {
-      return (*doors)[i].isOpenAtTime(step_mod_L);
+      stamp[i] = 0;
     }
+    epoch = 1;
   }
+}
+
+bool PlayerPathfinder::isDoorOpen(int pos, int step_mod_L) const
+{
+  if (!board)
+    return false;
 
-  return false; // Door ID not found
+  // Precomputed schedule: cells without a door are always open
+  return board->is_open_idx(pos, step_mod_L);
 }
 
 bool PlayerPathfinder::isPassable(int pos, int step_mod_L) const
@@ -102,90 +127,210 @@ bool PlayerPathfinder::isPassable(int pos, int step_mod_L) const
     return false;
 
   // Check if position is blocked (e.g., by a box)
-  for (int i = 0; i < blockedPositions.getSize(); i++)
-  {
-    if (blockedPositions[i] == pos)
-      return false;
-  }
+  if (blockedCells.test(pos))
+    return false;
 
   // Check if any door at this position is open
   return isDoorOpen(pos, step_mod_L);
 }
 
-void PlayerPathfinder::expandNeighbors(const Node &current, std::queue<Node> &bfs_queue)
+void PlayerPathfinder::findPaths(int start_pos, int start_step_mod_L)
+{
+  runSearch(start_pos, start_step_mod_L, nullptr, 0);
+}
+
+void PlayerPathfinder::findPathsTo(int start_pos, int start_step_mod_L, const CellBitset &targets, int targetCount)
+{
+  runSearch(start_pos, start_step_mod_L, &targets, targetCount);
+}
+
+// BFS over (pos, step_mod_L). With targets, stops once targetCount distinct
+// target cells have been reached; the first visit to a cell is its shortest.
+void PlayerPathfinder::runSearch(int start_pos, int start_step_mod_L, const CellBitset *targets, int targetCount)
 {
   if (!board)
     return;
 
+  // Reset all distances (also when the start is blocked, so a reused
+  // pathfinder never reports the previous search's results)
+  initializeTables();
+
+  if (start_step_mod_L < 0 || start_step_mod_L >= L || !isPassable(start_pos, start_step_mod_L))
+    return;
+
   int rows = board->get_height();
   int cols = board->get_width();
-  int L = board->getTimeModuloL();
-
-  // Get current position coordinates
-  int row = current.pos / cols;
-  int col = current.pos % cols;
 
   // Direction vectors: up, down, left, right
-  int dr[] = {-1, 1, 0, 0};
-  int dc[] = {0, 0, -1, 1};
-  char moves[] = {'U', 'D', 'L', 'R'};
+  static const int dr[] = {-1, 1, 0, 0};
+  static const int dc[] = {0, 0, -1, 1};
+  static const char moves[] = {'U', 'D', 'L', 'R'};
 
-  for (int i = 0; i < 4; i++)
+  // Start node
+  int start = start_pos * L + start_step_mod_L;
+  stamp[start] = epoch;
+  dist_table[start] = 0;
+  parent_index[start] = -1;
+  parent_move[start] = '\0';
+
+  CellBitset pending;
+  int remaining = 0;
+  if (targets)
   {
-    int new_row = row + dr[i];
-    int new_col = col + dc[i];
+    pending = *targets;
+    remaining = targetCount;
+    if (pending.test(start_pos))
+    {
+      pending.reset(start_pos);
+      remaining--;
+    }
+    if (remaining <= 0)
+      return;
+  }
 
-    // Check bounds
-    if (new_row < 0 || new_row >= rows || new_col < 0 || new_col >= cols)
-      continue;
+  // Unit-cost BFS: the first time an entry is reached is the shortest
+  int head = 0;
+  int tail = 0;
+  bfs_queue[tail++] = start;
 
-    int neighbor = new_row * cols + new_col;
-    int next_step = (current.step_mod_L + 1) % L;
+  while (head < tail)
+  {
+    int current = bfs_queue[head++];
+    int pos = current / L;
+    int row = pos / cols;
+    int col = pos % cols;
+    int next_step = (current % L + 1) % L;
+    int next_dist = dist_table[current] + 1;
+
+    for (int i = 0; i < 4; i++)
+    {
+      int new_row = row + dr[i];
+      int new_col = col + dc[i];
 
-    // Check if neighbor is passable at next time
-    if (!isPassable(neighbor, next_step))
-      continue;
+      // Check bounds
+      if (new_row < 0 || new_row >= rows || new_col < 0 || new_col >= cols)
+        continue;
 
-    // Check if we found a shorter path
-    int new_dist = current.dist + 1;
-    if (new_dist < dist_table[neighbor][next_step])
-    {
-      dist_table[neighbor][next_step] = new_dist;
-      parent_pos[neighbor][next_step] = current.pos;
-      parent_step[neighbor][next_step] = current.step_mod_L;
-      parent_move[neighbor][next_step] = moves[i];
+      int neighbor = new_row * cols + new_col;
+      int index = neighbor * L + next_step;
+      if (isVisited(index))
+        continue;
+
+      // Check if neighbor is passable at next time
+      if (!isPassable(neighbor, next_step))
+        continue;
+
+      stamp[index] = epoch;
+      dist_table[index] = next_dist;
+      parent_index[index] = current;
+      parent_move[index] = moves[i];
+      bfs_queue[tail++] = index;
 
-      bfs_queue.push(Node(neighbor, next_step, new_dist));
+      if (targets && pending.test(neighbor))
+      {
+        pending.reset(neighbor);
+        if (--remaining == 0)
+          return;
+      }
     }
   }
 }
 
-void PlayerPathfinder::findPaths(int start_pos, int start_step_mod_L)
+// Grow a row's reached bits sideways through its open cells
+static inline uint64_t spreadRow(uint64_t bits, uint64_t open)
 {
-  if (!board || !isPassable(start_pos, start_step_mod_L))
-    return;
+  uint64_t prev;
+  do
+  {
+    prev = bits;
+    bits |= ((bits << 1) | (bits >> 1)) & open;
+  } while (bits != prev);
+  return bits;
+}
 
-  // Reset all distances
-  initializeTables();
+void PlayerPathfinder::floodFill(int start_pos)
+{
+  int rows = board->get_height();
+  int cols = board->get_width();
 
-  // BFS queue
-  std::queue<Node> bfs_queue;
+  // Floor minus blocked cells
+  for (int r = 0; r < rows; r++)
+  {
+    openRows[r] = floorRows[r];
+    reachRows[r] = 0;
+  }
+  for (int w = 0; w < blockedCells.getWordCount(); w++)
+  {
+    uint64_t bits = blockedCells.getWord(w);
+    while (bits)
+    {
+      int pos = w * 64 + __builtin_ctzll(bits);
+      bits &= bits - 1;
+      if (pos < rows * cols)
+        openRows[pos / cols] &= ~(uint64_t(1) << (pos % cols));
+    }
+  }
 
-  // Start node
-  dist_table[start_pos][start_step_mod_L] = 0;
-  bfs_queue.push(Node(start_pos, start_step_mod_L, 0));
+  if (start_pos < 0 || start_pos >= rows * cols)
+    return;
+  int start_row = start_pos / cols;
+  uint64_t open = openRows[start_row];
+  uint64_t bits = (uint64_t(1) << (start_pos % cols)) & open;
+  if (!bits)
+    return;
+  reachRows[start_row] = spreadRow(bits, open);
 
-  while (!bfs_queue.empty())
+  // Alternate downward and upward sweeps until nothing changes. Each row
+  // takes its neighbours' bits, then spreads sideways within the row.
+  bool changed = true;
+  while (changed)
   {
-    Node current = bfs_queue.front();
-    bfs_queue.pop();
+    changed = false;
+    for (int pass = 0; pass < 2; pass++)
+    {
+      for (int k = 0; k < rows; k++)
+      {
+        int r = pass == 0 ? k : rows - 1 - k;
+        open = openRows[r];
+        bits = reachRows[r];
+        if (r > 0)
+          bits |= reachRows[r - 1];
+        if (r < rows - 1)
+          bits |= reachRows[r + 1];
+        bits &= open;
+        if (bits == reachRows[r])
+          continue;
+
+        reachRows[r] = spreadRow(bits, open);
+        changed = true;
+      }
+    }
+  }
+}
+
+int PlayerPathfinder::minReachableCell(int start_pos, int start_step_mod_L)
+{
+  if (!board)
+    return start_pos;
 
-    // Skip if we've found a better path already
-    if (current.dist > dist_table[current.pos][current.step_mod_L])
-      continue;
+  if (bitParallel)
+  {
+    floodFill(start_pos);
+    for (int r = 0; r < reachRows.getSize(); r++)
+    {
+      if (reachRows[r])
+        return r * board->get_width() + __builtin_ctzll(reachRows[r]);
+    }
+    return start_pos;
+  }
 
-    expandNeighbors(current, bfs_queue);
+  findPaths(start_pos, start_step_mod_L);
+  for (int pos = 0; pos < start_pos; pos++)
+  {
+    if (isVisited(pos * L + start_step_mod_L))
+      return pos;
   }
+  return start_pos;
 }
 
 int PlayerPathfinder::getDistance(int target_pos) const
@@ -194,13 +339,13 @@ int PlayerPathfinder::getDistance(int target_pos) const
     return -1;
 
   int min_dist = INT_MAX;
-  int L = board->getTimeModuloL();
 
   for (int t = 0; t < L; t++)
   {
-    if (dist_table[target_pos][t] < min_dist)
+    int dist = distanceAt(target_pos * L + t);
+    if (dist < min_dist)
     {
-      min_dist = dist_table[target_pos][t];
+      min_dist = dist;
     }
   }
 
@@ -211,10 +356,10 @@ int PlayerPathfinder::getDistance(int target_pos, int target_step_mod_L) const
 {
   if (!board || target_pos < 0 || target_pos >= board->get_width() * board->get_height())
     return -1;
-  if (target_step_mod_L < 0 || target_step_mod_L >= board->getTimeModuloL())
+  if (target_step_mod_L < 0 || target_step_mod_L >= L)
     return -1;
 
-  int dist = dist_table[target_pos][target_step_mod_L];
+  int dist = distanceAt(target_pos * L + target_step_mod_L);
   return (dist == INT_MAX) ? -1 : dist;
 }
 
@@ -227,13 +372,13 @@ Array<char> PlayerPathfinder::getPath(int target_pos) const
   // Find the minimum distance time slot
   int min_dist = INT_MAX;
   int best_time = -1;
-  int L = board->getTimeModuloL();
 
   for (int t = 0; t < L; t++)
   {
-    if (dist_table[target_pos][t] < min_dist)
+    int dist = distanceAt(target_pos * L + t);
+    if (dist < min_dist)
     {
-      min_dist = dist_table[target_pos][t];
+      min_dist = dist;
       best_time = t;
     }
   }
@@ -253,16 +398,12 @@ Array<char> PlayerPathfinder::getPath(int target_pos, int target_step_mod_L) con
 
   // Reconstruct path backwards
   Array<char> reverse_path;
-  int pos = target_pos;
-  int step = target_step_mod_L;
+  int index = target_pos * L + target_step_mod_L;
 
-  while (parent_pos[pos][step] != -1)
+  while (parent_index[index] != -1)
   {
-    reverse_path.push_back(parent_move[pos][step]);
-    int next_pos = parent_pos[pos][step];
-    int next_step = parent_step[pos][step];
-    pos = next_pos;
-    step = next_step;
+    reverse_path.push_back(parent_move[index]);
+    index = parent_index[index];
   }
 
   // Reverse the path to get forward direction
@@ -282,7 +423,6 @@ void PlayerPathfinder::printDistanceTable() const
   std::cout << "Distance Table:\n";
   int rows = board->get_height();
   int cols = board->get_width();
-  int L = board->getTimeModuloL();
 
   for (int t = 0; t < L; t++)
   {
@@ -292,7 +432,7 @@ void PlayerPathfinder::printDistanceTable() const
       for (int c = 0; c < cols; c++)
       {
         int pos = r * cols + c;
-        int dist = dist_table[pos][t];
+        int dist = distanceAt(pos * L + t);
         if (dist == INT_MAX)
         {
           std::cout << "INF ";
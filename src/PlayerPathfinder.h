@@ -3,41 +3,45 @@
 #include "Board.h"
 #include "Door.h"
 #include "Array.h"
-#include <queue>
+#include "CellBitset.h"
 #include <climits>
 
-// Node structure for BFS pathfinding
-struct Node
-{
-  int pos;        // Cell index on the board
-  int step_mod_L; // Time modulo L
-  int dist;       // Steps taken to reach this node
-
-  Node() : pos(-1), step_mod_L(0), dist(0) {}
-  Node(int position, int stepMod, int distance) : pos(position), step_mod_L(stepMod), dist(distance) {}
-};
-
 // Player pathfinder with door timing awareness
 class PlayerPathfinder
 {
 private:
   const Board *board;
   const Array<Door> *doors;
-  Array<int> blockedPositions;  // Positions that should be treated as impassable (e.g., box positions)
+  CellBitset blockedCells;  // Cells that should be treated as impassable (e.g., box positions)
 
-  // 2D distance array: dist[pos][step_mod_L]
-  Array<Array<int>> dist_table;
+  // Flat BFS tables over (pos, step_mod_L), indexed pos * L + t.
+  // Sized once per board; an entry is only valid when its stamp equals the
+  // current epoch, so starting a new search is O(1).
+  int L;                    // Time modulo L of the board
+  int tableSize;            // board_size * L
+  Array<int> dist_table;    // Steps from the start
+  Array<int> parent_index;  // Predecessor (pos * L + t), -1 at the start
+  Array<char> parent_move;  // Move taken from the predecessor
+  Array<int> stamp;         // Epoch that last wrote the entry
+  Array<int> bfs_queue;     // Flat BFS queue of table indices
+  int epoch;
 
-  // Parent tracking for path reconstruction
-  Array<Array<int>> parent_pos;
-  Array<Array<int>> parent_step;
-  Array<Array<char>> parent_move;
+  // Bit-parallel reachability for boards with L == 1 and width <= 64:
+  // one word per row, bit c set for column c
+  bool bitParallel;
+  Array<uint64_t> floorRows; // Cells the player may ever stand on (no wall, open door)
+  Array<uint64_t> openRows;  // floorRows minus blocked cells, rebuilt per fill
+  Array<uint64_t> reachRows; // Result of the last floodFill
 
   // Helper methods
   void initializeTables();
+  void initializeFloorRows();
+  void runSearch(int start_pos, int start_step_mod_L, const CellBitset *targets, int targetCount);
+  void newEpoch();
+  bool isVisited(int index) const { return stamp[index] == epoch; }
+  int distanceAt(int index) const { return isVisited(index) ? dist_table[index] : INT_MAX; }
   bool isDoorOpen(int pos, int step_mod_L) const;
   bool isPassable(int pos, int step_mod_L) const;
-  void expandNeighbors(const Node &current, std::queue<Node> &bfs_queue);
 
 public:
   PlayerPathfinder();
@@ -48,10 +52,30 @@ public:
 
   // Set blocked positions (e.g., box positions that player cannot walk through)
   void setBlockedPositions(const Array<int> &blocked);
+  void setBlockedCells(const CellBitset &blocked); // Same, from an occupancy bitset
 
   // Run BFS from starting position and time
   void findPaths(int start_pos, int start_step_mod_L);
 
+  // Same, but stop as soon as every target cell has a distance. Only the
+  // targets' distances (getDistance(pos)) are guaranteed afterwards.
+  void findPathsTo(int start_pos, int start_step_mod_L, const CellBitset &targets, int targetCount);
+
+  // Bit-parallel flood fill of the player's reachable region (no distances).
+  // Only available on door-free boards (L == 1) at most 64 cells wide.
+  bool hasBitParallelFill() const { return bitParallel; }
+  void floodFill(int start_pos);
+  bool isReachable(int pos) const
+  {
+    int cols = board->get_width();
+    return (reachRows[pos / cols] >> (pos % cols)) & 1u;
+  }
+
+  // Smallest cell index the player can reach from start (on door boards:
+  // reach at a step count that is a multiple of L). Uses the fill when
+  // available, otherwise a full BFS; start_pos if the start is blocked.
+  int minReachableCell(int start_pos, int start_step_mod_L);
+
   // Query results
   int getDistance(int target_pos) const;                        // Returns minimum distance across all times
   int getDistance(int target_pos, int target_step_mod_L) const; // Specific time
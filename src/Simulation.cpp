@@ -1,34 +1,75 @@
 #include "Simulation.h"
 #include <iostream>
 
-void Simulation::reconstruct_moves(AStarNode *goalNode, Array<char> &outMoves)
+void Simulation::reconstruct_moves(const Board &board, const Array<Door> &doors,
+                                   const NodeArena<AStarNode> &nodes, const PackedStatePool &states,
+                                   const StatePacker &packer, uint32_t goalId, Array<char> &outMoves)
 {
+  // Direction vectors for movement: up, down, left, right
+  static const int dr[] = {-1, 1, 0, 0};
+  static const int dc[] = {0, 0, -1, 1};
+  static const char moves[] = {'U', 'D', 'L', 'R'};
+
   // Clear output array
   while (outMoves.getSize() > 0)
   {
     outMoves.pop_back();
   }
 
-  if (!goalNode)
+  if (goalId == NodeArena<AStarNode>::NO_NODE || goalId >= nodes.getSize())
     return;
 
-  // Collect all action sequences by walking parent pointers
-  Array<Array<char> *> actionSequences;
-  AStarNode *current = goalNode;
-
-  while (current && current->parent)
+  // Collect the solution chain (goal first)
+  Array<int> chain;
+  for (uint32_t current = goalId; current != NodeArena<AStarNode>::NO_NODE; current = nodes.get(current).parent)
   {
-    actionSequences.push_back(&current->actionsFromParent);
-    current = reinterpret_cast<AStarNode *>(current->parent);
+    chain.push_back(static_cast<int>(current));
   }
 
-  // Reverse order and concatenate all actions
-  for (int i = actionSequences.getSize() - 1; i >= 0; i--)
+  int cols = board.get_width();
+  PlayerPathfinder pathfinder;
+  pathfinder.initialize(board, doors);
+
+  // Replay root to goal: walk from the parent state, then push
+  for (int i = chain.getSize() - 1; i > 0; i--)
   {
-    Array<char> *actions = actionSequences[i];
-    for (int j = 0; j < actions->getSize(); j++)
+    State from;
+    State to;
+    packer.unpack(states.get(chain[i]), from);
+    packer.unpack(states.get(chain[i - 1]), to);
+    char action = nodes.get(chain[i - 1]).action;
+
+    pathfinder.setBlockedCells(from.getBoxCells());
+    pathfinder.findPaths(from.getPlayerPos(), from.getStepModL());
+
+    // A key pickup ends on the key; a push starts on the cell behind the
+    // box's old position, which is where the player stands afterwards
+    int walkTarget = to.getPlayerPos();
+    int dir = -1;
+    if (action != 'K')
+    {
+      for (int d = 0; d < 4; d++)
+      {
+        if (moves[d] == action)
+        {
+          dir = d;
+          break;
+        }
+      }
+      if (dir == -1)
+        continue; // No action recorded
+
+      walkTarget = (to.getPlayerPos() / cols - dr[dir]) * cols + (to.getPlayerPos() % cols - dc[dir]);
+    }
+
+    Array<char> walk = pathfinder.getPath(walkTarget);
+    for (int j = 0; j < walk.getSize(); j++)
+    {
+      outMoves.push_back(walk[j]);
+    }
+    if (dir != -1)
     {
-      outMoves.push_back((*actions)[j]);
+      outMoves.push_back(action);
     }
   }
 }
@@ -79,8 +79,12 @@ struct DynamicState
 class Simulation
 {
 public:
-  // Path reconstruction from A* solver nodes
-  static void reconstruct_moves(AStarNode *goalNode, Array<char> &outMoves);
+  // Path reconstruction from A* solver nodes: walks parent ids in the arena
+  // and recomputes the player walk before each push with a pathfinder run
+  // from the parent's packed state (only solution nodes pay for this)
+  static void reconstruct_moves(const Board &board, const Array<Door> &doors,
+                                const NodeArena<AStarNode> &nodes, const PackedStatePool &states,
+                                const StatePacker &packer, uint32_t goalId, Array<char> &outMoves);
 
   // Apply a single player move (U/D/L/R) to the dynamic state
   static bool applyPlayerMove(const Board &board, DynamicState &ds, char move,
@@ -3,7 +3,7 @@
 #include <iomanip>
 
 SokobanHeuristics::SokobanHeuristics()
-    : board(nullptr)
+    : board(nullptr), reachabilityKnown(false), parentValid(false), parentH(0), parentBoxCount(0)
 {
 }
 
@@ -37,9 +37,27 @@ void SokobanHeuristics::initialize(const Board &b)
 
   std::cout << "Found " << precomputed.goalPositions.getSize() << " goal positions" << std::endl;
 
-  // Precompute goal distances and corner detection
+  // Precompute goal distances, corner detection and the dead squares they imply
   precomputeGoalDistances();
   precomputeCorners();
+  precomputeDeadSquares();
+  precomputeRegions();
+  patterns.initialize(b, deadSquares);
+
+  // The offline table does not depend on the board; a missing file only
+  // turns it off
+  if (!deadlockTable.isLoaded())
+  {
+    deadlockTable.load(PatternTable::DEFAULT_PATH);
+  }
+  deadlockTable.bind(b);
+
+  // Door reachability depends on the level's start (initializeReachability)
+  reachabilityKnown = false;
+  playerReachable.clear();
+  boxReachable.clear();
+  unreachableGoals.clear();
+  doorDeadSquares.clear();
 }
 
 void SokobanHeuristics::precomputeGoalDistances()
@@ -68,66 +86,165 @@ void SokobanHeuristics::precomputeGoalDistances()
     precomputed.goalDist.push_back(goal_array);
   }
 
-  // Run BFS from each goal
+  // Pull boxes away from each goal
+  precomputeSideRegions();
   for (int g = 0; g < num_goals; g++)
   {
-    runBFSFromGoal(g, precomputed.goalPositions[g]);
+    runPullBFSFromGoal(g, precomputed.goalPositions[g]);
   }
 
-  std::cout << "Precomputed BFS distances from " << num_goals << " goals" << std::endl;
+  std::cout << "Precomputed push distances from " << num_goals << " goals" << std::endl;
 }
 
-void SokobanHeuristics::runBFSFromGoal(int goalIndex, int goalPos)
+// Direction vectors: up, down, left, right
+static const int pull_dr[] = {-1, 1, 0, 0};
+static const int pull_dc[] = {0, 0, -1, 1};
+
+bool SokobanHeuristics::isFloor(int row, int col) const
 {
-  if (!board)
-    return;
+  if (row < 0 || row >= board->get_height() || col < 0 || col >= board->get_width())
+    return false;
+  return !board->is_wall_idx(row * board->get_width() + col);
+}
 
+void SokobanHeuristics::precomputeSideRegions()
+{
   int width = board->get_width();
   int height = board->get_height();
+  int board_size = width * height;
 
-  std::queue<int> bfs_queue;
-
-  // Start BFS from goal position
-  precomputed.goalDist[goalIndex][goalPos] = 0;
-  bfs_queue.push(goalPos);
-
-  // Direction vectors: up, down, left, right
-  int dr[] = {-1, 1, 0, 0};
-  int dc[] = {0, 0, -1, 1};
-
-  while (!bfs_queue.empty())
+  sideRegion = Array<uint8_t>();
+  for (int i = 0; i < board_size * 4; i++)
   {
-    int current_pos = bfs_queue.front();
-    bfs_queue.pop();
+    sideRegion.push_back(uint8_t(NO_SIDE));
+  }
 
-    int current_dist = precomputed.goalDist[goalIndex][current_pos];
+  // Flood fill scratch: cells stamped with the current fill's number
+  Array<int> mark;
+  Array<int> stack;
+  for (int i = 0; i < board_size; i++)
+  {
+    mark.push_back(0);
+    stack.push_back(0);
+  }
+  int fill = 0;
 
-    // Get current coordinates
-    int row = current_pos / width;
-    int col = current_pos % width;
+  for (int pos = 0; pos < board_size; pos++)
+  {
+    if (board->is_wall_idx(pos))
+      continue;
+    int row = pos / width;
+    int col = pos % width;
 
-    // Explore all 4 directions
-    for (int dir = 0; dir < 4; dir++)
+    // Neighbour cells, -1 where the player cannot stand
+    int side[4];
+    for (int d = 0; d < 4; d++)
     {
-      int new_row = row + dr[dir];
-      int new_col = col + dc[dir];
+      int r = row + pull_dr[d];
+      int c = col + pull_dc[d];
+      side[d] = isFloor(r, c) ? r * width + c : -1;
+    }
 
-      // Check bounds
-      if (new_row < 0 || new_row >= height || new_col < 0 || new_col >= width)
+    for (int d = 0; d < 4; d++)
+    {
+      if (side[d] < 0 || sideRegion[pos * 4 + d] != NO_SIDE)
         continue;
 
-      int new_pos = new_row * width + new_col;
+      // Fill from this side with the box on pos as an obstacle; every
+      // other side reached shares its label
+      fill++;
+      mark[pos] = fill;
+      mark[side[d]] = fill;
+      int top = 0;
+      stack[top++] = side[d];
+      while (top > 0)
+      {
+        int current = stack[--top];
+        int r = current / width;
+        int c = current % width;
+        for (int k = 0; k < 4; k++)
+        {
+          int nr = r + pull_dr[k];
+          int nc = c + pull_dc[k];
+          if (!isFloor(nr, nc) || mark[nr * width + nc] == fill)
+            continue;
+          mark[nr * width + nc] = fill;
+          stack[top++] = nr * width + nc;
+        }
+      }
 
-      // Check if position is passable (not a wall)
-      if (board->is_wall_idx(new_pos))
-        continue;
+      for (int k = d; k < 4; k++)
+      {
+        if (side[k] >= 0 && mark[side[k]] == fill)
+          sideRegion[pos * 4 + k] = d;
+      }
+    }
+  }
+}
+
+// Reverse search from a goal: a box on cell b with the player on side d
+// (cell b + d) can be pulled to b + d if b + 2d is floor, leaving the player
+// on side d of the new cell. Moving between connected sides is free. The
+// first time a cell is reached is the fewest pushes that can bring a box
+// from there to the goal; cells never reached keep INT_MAX. Other boxes and
+// door timing are ignored, so the bound stays admissible.
+void SokobanHeuristics::runPullBFSFromGoal(int goalIndex, int goalPos)
+{
+  if (!board)
+    return;
+
+  int width = board->get_width();
+  Array<int> &dist = precomputed.goalDist[goalIndex];
+
+  // States are cell * 4 + side; -1 = not reached
+  Array<int> pulls;
+  Array<int> queue;
+  for (int i = 0; i < sideRegion.getSize(); i++)
+  {
+    pulls.push_back(-1);
+    queue.push_back(0);
+  }
+  int head = 0;
+  int tail = 0;
+
+  // The last push leaves the player on any side of the goal
+  dist[goalPos] = 0;
+  for (int d = 0; d < 4; d++)
+  {
+    if (sideRegion[goalPos * 4 + d] != NO_SIDE)
+    {
+      pulls[goalPos * 4 + d] = 0;
+      queue[tail++] = goalPos * 4 + d;
+    }
+  }
+
+  while (head < tail)
+  {
+    int state = queue[head++];
+    int pos = state / 4;
+    int d = state % 4;
+    int row = pos / width;
+    int col = pos % width;
+
+    // Pull towards the player, who steps back one more cell
+    if (!isFloor(row + 2 * pull_dr[d], col + 2 * pull_dc[d]))
+      continue;
+    int next = (row + pull_dr[d]) * width + col + pull_dc[d];
+    if (pulls[next * 4 + d] >= 0)
+      continue;
+
+    int next_pulls = pulls[state] + 1;
+    if (dist[next] == INT_MAX)
+      dist[next] = next_pulls;
 
-      // Check if we found a shorter path
-      int new_dist = current_dist + 1;
-      if (new_dist < precomputed.goalDist[goalIndex][new_pos])
+    // The player can reach every side connected to the one it stands on
+    uint8_t region = sideRegion[next * 4 + d];
+    for (int k = 0; k < 4; k++)
+    {
+      if (sideRegion[next * 4 + k] == region && pulls[next * 4 + k] < 0)
       {
-        precomputed.goalDist[goalIndex][new_pos] = new_dist;
-        bfs_queue.push(new_pos);
+        pulls[next * 4 + k] = next_pulls;
+        queue[tail++] = next * 4 + k;
       }
     }
   }
@@ -153,6 +270,110 @@ void SokobanHeuristics::precomputeCorners()
   std::cout << "Precomputed corner detection for deadlock analysis" << std::endl;
 }
 
+void SokobanHeuristics::precomputeDeadSquares()
+{
+  int board_size = board->get_width() * board->get_height();
+  int num_goals = precomputed.goalPositions.getSize();
+  bool have_distances = precomputed.goalDist.getSize() == num_goals;
+
+  deadCorners.clear();
+  deadSquares.clear();
+  for (int pos = 0; pos < board_size; pos++)
+  {
+    if (board->is_wall_idx(pos) || isGoalPosition[pos])
+      continue;
+
+    if (isCorner[pos])
+    {
+      deadCorners.set(pos);
+      deadSquares.set(pos);
+      continue;
+    }
+
+    bool reaches_goal = false;
+    for (int g = 0; have_distances && g < num_goals && !reaches_goal; g++)
+    {
+      reaches_goal = precomputed.getDistance(g, pos) != INT_MAX;
+    }
+    if (!reaches_goal)
+      deadSquares.set(pos);
+  }
+}
+
+// Walls and doors that are closed in every time slot split the board
+bool SokobanHeuristics::isStaticFloor(int pos) const
+{
+  if (board->is_wall_idx(pos))
+    return false;
+  for (int t = 0; t < board->getTimeModuloL(); t++)
+  {
+    if (board->is_open_idx(pos, t))
+      return true;
+  }
+  return false;
+}
+
+// Union-find root with path halving
+static int findRegionRoot(Array<int> &parent, int cell)
+{
+  while (parent[cell] != cell)
+  {
+    parent[cell] = parent[parent[cell]];
+    cell = parent[cell];
+  }
+  return cell;
+}
+
+void SokobanHeuristics::precomputeRegions()
+{
+  int width = board->get_width();
+  int board_size = width * board->get_height();
+
+  // Union each floor cell with its floor neighbours to the right and below
+  Array<int> parent;
+  for (int pos = 0; pos < board_size; pos++)
+  {
+    parent.push_back(pos);
+  }
+  for (int pos = 0; pos < board_size; pos++)
+  {
+    if (!isStaticFloor(pos))
+      continue;
+    int right = pos + 1;
+    int below = pos + width;
+    if ((pos + 1) % width != 0 && isStaticFloor(right))
+      parent[findRegionRoot(parent, right)] = findRegionRoot(parent, pos);
+    if (below < board_size && isStaticFloor(below))
+      parent[findRegionRoot(parent, below)] = findRegionRoot(parent, pos);
+  }
+
+  // Dense region ids, with goal counts
+  regionOf = Array<int>();
+  regionGoals = Array<int>();
+  regionBoxes = Array<int>();
+  Array<int> rootRegion;
+  for (int pos = 0; pos < board_size; pos++)
+  {
+    regionOf.push_back(-1);
+    rootRegion.push_back(-1);
+  }
+  for (int pos = 0; pos < board_size; pos++)
+  {
+    if (!isStaticFloor(pos))
+      continue;
+    int root = findRegionRoot(parent, pos);
+    if (rootRegion[root] < 0)
+    {
+      rootRegion[root] = regionGoals.getSize();
+      regionGoals.push_back(0);
+      regionBoxes.push_back(0);
+    }
+    regionOf[pos] = rootRegion[root];
+    if (isGoalPosition[pos])
+      regionGoals[regionOf[pos]]++;
+  }
+}
+
 bool SokobanHeuristics::isCellCorner(int pos) const
 {
   if (!board || board->is_wall_idx(pos))
@@ -238,16 +459,96 @@ int SokobanHeuristics::heuristic_assignment(const State &s, const Board &board,
   if (num_boxes > num_goals)
     return 999999;
 
-  // Build cost matrix: cost[i][j] = distance from box[i] to goal[j]
-  Array<Array<int>> costMatrix;
-  buildCostMatrix(s, costMatrix);
+  // Build cost matrix: cost[i * num_goals + j] = distance from box[i] to goal[j]
+  buildCostMatrix(s, costScratch);
 
   // Use Hungarian algorithm to find optimal assignment
-  int optimal_cost = hungarianAlgorithm(costMatrix, num_boxes, num_goals);
+  int optimal_cost = hungarianAlgorithm(costScratch, num_boxes, num_goals);
 
   return optimal_cost;
 }
 
+void SokobanHeuristics::setParent(const State &parent)
+{
+  // The one-row repair needs a square matrix: as many boxes as goals
+  int num_boxes = parent.getBoxCount();
+  parentValid = board && num_boxes > 0 && num_boxes == precomputed.getNumGoals();
+  if (!parentValid)
+    return;
+
+  buildCostMatrix(parent, parentCost);
+  parentH = hungarianAlgorithm(parentCost, num_boxes, num_boxes);
+  assignment.keepAsBase();
+
+  parentBoxCount = num_boxes;
+  while (parentBoxes.getSize() < num_boxes)
+  {
+    parentBoxes.push_back(0);
+  }
+  for (int i = 0; i < num_boxes; i++)
+  {
+    parentBoxes[i] = parent.getBox(i).pos;
+  }
+  parentCells = parent.getBoxCells();
+}
+
+int SokobanHeuristics::heuristicFromParent(const State &child) const
+{
+  int n = parentBoxCount;
+  if (!parentValid || child.getBoxCount() != n)
+    return heuristic(child);
+
+  // Find the parent row whose box moved, and where it went
+  int row = -1;
+  int moved = 0;
+  for (int i = 0; i < n; i++)
+  {
+    if (!child.hasBoxAt(parentBoxes[i]))
+    {
+      row = i;
+      moved++;
+    }
+  }
+  if (moved == 0)
+    return parentH; // Same boxes (key pickup)
+  if (moved > 1)
+    return heuristic(child);
+
+  int new_pos = -1;
+  for (int i = 0; i < n; i++)
+  {
+    if (!parentCells.test(child.getBox(i).pos))
+    {
+      new_pos = child.getBox(i).pos;
+      break;
+    }
+  }
+
+  // Patch the moved box's row, repair, then restore the parent's row
+  int *costRow = &parentCost[row * n];
+  while (savedRow.getSize() < n)
+  {
+    savedRow.push_back(0);
+  }
+  for (int j = 0; j < n; j++)
+  {
+    savedRow[j] = costRow[j];
+    costRow[j] = pushCost(j, new_pos);
+  }
+
+  int h = assignment.solveChangedRow(&parentCost[0], n, row);
+
+  for (int j = 0; j < n; j++)
+  {
+    costRow[j] = savedRow[j];
+  }
+
+#ifdef DEBUG
+  assert(h == heuristic(child));
+#endif
+  return h;
+}
+
 bool SokobanHeuristics::isDeadlocked(const State &s) const
 {
   if (!board)
@@ -265,6 +566,148 @@ bool SokobanHeuristics::isDeadlocked(const State &s) const
   if (isMultiboxDeadlocked(s))
     return true;
 
+  // Stage 4: Door-cycle deadlock detection (empty until initializeReachability)
+  if (isDoorCycleDeadlocked(s))
+    return true;
+
+  return false;
+}
+
+int SokobanHeuristics::pushedBoxPos(const State &s) const
+{
+  int width = board->get_width();
+  int pos = s.getPlayerPos();
+  switch (s.getActionFromParent())
+  {
+  case 'U':
+    pos -= width;
+    break;
+  case 'D':
+    pos += width;
+    break;
+  case 'L':
+    pos -= 1;
+    break;
+  case 'R':
+    pos += 1;
+    break;
+  default:
+    return -1; // Key pickup or root: boxes are as in a checked state
+  }
+  return s.hasBoxAt(pos) ? pos : -1;
+}
+
+bool SokobanHeuristics::isPushDeadlocked(const State &s) const
+{
+  if (!board)
+    return false;
+
+  int pos = pushedBoxPos(s);
+  if (pos < 0)
+    return false;
+
+  // Stages 1, 2 and 4 for the one box that moved. Stage 3 region capacity
+  // needs nothing: a push moves a box between adjacent cells of one static
+  // region, so the counts checked at the root never change.
+  if (deadSquares.test(pos) || doorDeadSquares.test(pos))
+    return true;
+
+  return deadlockTable.matches(s.getBoxCells(), pos) || isFreezeDeadlocked(s, pos) ||
+         patterns.matches(s.getBoxCells(), pos);
+}
+
+bool SokobanHeuristics::isPushedBoxStuck(const State &s) const
+{
+  if (!board)
+    return false;
+
+  int pos = pushedBoxPos(s);
+  if (pos < 0)
+    return false;
+
+  // An axis is pushable when the cells on both sides are free floor
+  int width = board->get_width();
+  int board_size = width * board->get_height();
+  int steps[2] = {1, width};
+  for (int k = 0; k < 2; k++)
+  {
+    int before = pos - steps[k];
+    int after = pos + steps[k];
+    bool outside = before < 0 || after >= board_size || (k == 0 && before / width != after / width);
+    if (!outside && !board->is_wall_idx(before) && !board->is_wall_idx(after) &&
+        !s.hasBoxAt(before) && !s.hasBoxAt(after))
+      return false;
+  }
+  return true;
+}
+
+bool SokobanHeuristics::learnDeadlock(const State &s)
+{
+  if (!board)
+    return false;
+
+  int pos = pushedBoxPos(s);
+  return pos >= 0 && patterns.learn(s.getBoxCells(), pos);
+}
+
+bool SokobanHeuristics::isFreezeDeadlocked(const State &s, int pos) const
+{
+  if (!board)
+    return false;
+
+  bool offGoal = false;
+  freezeStack.clear();
+  return isFrozenBox(s, pos, offGoal) && offGoal;
+}
+
+// A box is frozen when it is blocked along both axes. It stays on the
+// stack while its neighbours are examined, so they see it as a wall: if
+// every box in a cluster is blocked assuming the others stay put, none of
+// them can move first. Neighbours' goal flags only count once this box is
+// known to be frozen, since they were frozen assuming it was.
+bool SokobanHeuristics::isFrozenBox(const State &s, int pos, bool &offGoal) const
+{
+  bool clusterOffGoal = false;
+  freezeStack.set(pos);
+  bool frozen = isAxisBlocked(s, pos, 1, clusterOffGoal) &&
+                isAxisBlocked(s, pos, board->get_width(), clusterOffGoal);
+  freezeStack.reset(pos);
+
+  if (frozen)
+  {
+    // A frozen box is only fine on a goal, and unlocked (a locked box is
+    // unlocked by pushing it)
+    int index = s.findBoxAt(pos);
+    if (clusterOffGoal || !isGoalPosition[pos] || s.getBox(index).id != 0)
+      offGoal = true;
+  }
+  return frozen;
+}
+
+// step is 1 for the horizontal axis, the board width for the vertical one
+bool SokobanHeuristics::isAxisBlocked(const State &s, int pos, int step, bool &offGoal) const
+{
+  int width = board->get_width();
+  int board_size = width * board->get_height();
+  int side[2] = {pos - step, pos + step};
+
+  for (int k = 0; k < 2; k++)
+  {
+    int cell = side[k];
+    bool outside = cell < 0 || cell >= board_size || (step == 1 && cell / width != pos / width);
+    if (outside || board->is_wall_idx(cell) || freezeStack.test(cell))
+      return true;
+  }
+
+  // Pushing along this axis only leads onto dead squares
+  if (deadSquares.test(side[0]) && deadSquares.test(side[1]))
+    return true;
+
+  for (int k = 0; k < 2; k++)
+  {
+    if (s.hasBoxAt(side[k]) && isFrozenBox(s, side[k], offGoal))
+      return true;
+  }
   return false;
 }
 
@@ -297,25 +740,8 @@ bool SokobanHeuristics::isCornerDeadlocked(const State &s) const
   if (!board)
     return false;
 
-  // Stage 1: Corner deadlock detection
-  for (int box_idx = 0; box_idx < s.getBoxCount(); box_idx++)
-  {
-    const BoxInfo &box = s.getBox(box_idx);
-    int box_pos = box.pos;
-
-    // Check if box is in a corner
-    if (isCorner[box_pos])
-    {
-      // Check if this corner position is a goal
-      if (!isGoalPosition[box_pos])
-      {
-        // Box is in a non-goal corner - this is a deadlock!
-        return true;
-      }
-    }
-  }
-
-  return false;
+  // Stage 1: any box in a non-goal corner
+  return s.getBoxCells().intersects(deadCorners);
 }
 
 bool SokobanHeuristics::isWallDeadlocked(const State &s) const
@@ -323,38 +749,9 @@ bool SokobanHeuristics::isWallDeadlocked(const State &s) const
   if (!board)
     return false;
 
-  // Stage 2: Wall deadlock detection
-  // Only detect wall deadlock if box is in a corner (handled by corner deadlock)
-  // or if box is provably unreachable from all goals
-  for (int box_idx = 0; box_idx < s.getBoxCount(); box_idx++)
-  {
-    const BoxInfo &box = s.getBox(box_idx);
-    int box_pos = box.pos;
-
-    // Skip if box is already on a goal
-    if (isGoalPosition[box_pos])
-      continue;
-
-    // Check if box has infinite distance to all goals
-    // This means it's unreachable from any goal
-    bool unreachable_from_all_goals = true;
-    for (int goal_idx = 0; goal_idx < precomputed.getNumGoals(); goal_idx++)
-    {
-      int distance = precomputed.getDistance(goal_idx, box_pos);
-      if (distance != INT_MAX)
-      {
-        unreachable_from_all_goals = false;
-        break;
-      }
-    }
-
-    if (unreachable_from_all_goals)
-    {
-      return true; // Box cannot reach any goal
-    }
-  }
-
-  return false;
+  // Stage 2: any box on a cell no goal can be reached from by pushing
+  // (against a goal-less wall, in a dead-end, or a corner)
+  return s.getBoxCells().intersects(deadSquares);
 }
 
 void SokobanHeuristics::printGoalDistances() const
@@ -435,138 +832,46 @@ void SokobanHeuristics::printCornerMap() const
   }
 }
 
-// Build cost matrix for Hungarian algorithm
-void SokobanHeuristics::buildCostMatrix(const State &s, Array<Array<int>> &costMatrix) const
+// Build cost matrix for Hungarian algorithm (row-major, one row per box)
+void SokobanHeuristics::buildCostMatrix(const State &s, Array<int> &costMatrix) const
 {
   int num_boxes = s.getBoxCount();
   int num_goals = precomputed.getNumGoals();
 
-  costMatrix = Array<Array<int>>();
+  // Only grows: after the first call with the most boxes, no allocation
+  while (costMatrix.getSize() < num_boxes * num_goals)
+  {
+    costMatrix.push_back(0);
+  }
 
   for (int box_idx = 0; box_idx < num_boxes; box_idx++)
   {
-    Array<int> row;
     const BoxInfo &box = s.getBox(box_idx);
     int box_pos = box.pos;
+    int *row = &costMatrix[box_idx * num_goals];
 
     for (int goal_idx = 0; goal_idx < num_goals; goal_idx++)
     {
-      int distance = precomputed.getDistance(goal_idx, box_pos);
-      if (distance == INT_MAX)
-      {
-        distance = 999999; // Use large but finite value
-      }
-      row.push_back(distance);
+      row[goal_idx] = pushCost(goal_idx, box_pos);
     }
-    costMatrix.push_back(row);
   }
 }
 
-// Simplified Hungarian algorithm implementation
-int SokobanHeuristics::hungarianAlgorithm(const Array<Array<int>> &costMatrix, int n, int m) const
+int SokobanHeuristics::pushCost(int goalIndex, int pos) const
+{
+  int distance = precomputed.getDistance(goalIndex, pos);
+  if (distance == INT_MAX || unreachableGoals.test(precomputed.getGoalPosition(goalIndex)))
+    return UNREACHABLE_COST; // Large but finite, so sums stay in range
+  return distance;
+}
+
+// Optimal box-to-goal assignment (exact for any number of boxes)
+int SokobanHeuristics::hungarianAlgorithm(const Array<int> &costMatrix, int n, int m) const
 {
   if (n == 0)
     return 0;
 
-  // For small problems, use brute force approach
-  if (n <= 3 && m <= 3)
-  {
-    // Try all possible assignments and find minimum
-    int min_cost = INT_MAX;
-
-    // Generate all permutations of goal assignments
-    Array<int> assignment;
-    for (int i = 0; i < n; i++)
-    {
-      assignment.push_back(i);
-    }
-
-    // Simple brute force for small cases
-    if (n == 1)
-    {
-      min_cost = costMatrix[0][0];
-      for (int j = 1; j < m; j++)
-      {
-        if (costMatrix[0][j] < min_cost)
-          min_cost = costMatrix[0][j];
-      }
-    }
-    else if (n == 2 && m >= 2)
-    {
-      // Try both assignments: (0,0)(1,1) vs (0,1)(1,0)
-      for (int j1 = 0; j1 < m; j1++)
-      {
-        for (int j2 = 0; j2 < m; j2++)
-        {
-          if (j1 != j2) // Different goals
-          {
-            int cost = costMatrix[0][j1] + costMatrix[1][j2];
-            if (cost < min_cost)
-              min_cost = cost;
-          }
-        }
-      }
-    }
-    else if (n == 3 && m >= 3)
-    {
-      // Try all 3! = 6 permutations
-      for (int j1 = 0; j1 < m; j1++)
-      {
-        for (int j2 = 0; j2 < m; j2++)
-        {
-          for (int j3 = 0; j3 < m; j3++)
-          {
-            if (j1 != j2 && j1 != j3 && j2 != j3)
-            {
-              int cost = costMatrix[0][j1] + costMatrix[1][j2] + costMatrix[2][j3];
-              if (cost < min_cost)
-                min_cost = cost;
-            }
-          }
-        }
-      }
-    }
-
-    return (min_cost == INT_MAX) ? 999999 : min_cost;
-  }
-
-  // For larger problems, fall back to greedy approximation
-  // This is not optimal but provides a reasonable bound
-  Array<bool> used_goals;
-  for (int i = 0; i < m; i++)
-  {
-    used_goals.push_back(false);
-  }
-
-  int total_cost = 0;
-
-  for (int box_idx = 0; box_idx < n; box_idx++)
-  {
-    int best_cost = INT_MAX;
-    int best_goal = -1;
-
-    // Find cheapest available goal for this box
-    for (int goal_idx = 0; goal_idx < m; goal_idx++)
-    {
-      if (!used_goals[goal_idx] && costMatrix[box_idx][goal_idx] < best_cost)
-      {
-        best_cost = costMatrix[box_idx][goal_idx];
-        best_goal = goal_idx;
-      }
-    }
-
-    if (best_goal >= 0)
-    {
-      used_goals[best_goal] = true;
-      total_cost += best_cost;
-    }
-    else
-    {
-      return 999999; // No valid assignment
-    }
-  }
-
-  return total_cost;
+  return assignment.solve(&costMatrix[0], n, m);
 }
 
 // Wall deadlock detection helpers
@@ -713,11 +1018,40 @@ bool SokobanHeuristics::isMultiboxDeadlocked(const State &s) const
   if (!board)
     return false;
 
-  // Disable multibox deadlock for now as it has false positives
+  // Corridor detection is disabled for now as it has false positives
   // TODO: Improve multibox deadlock detection accuracy
-  return false;
-  
   // return is_multibox_deadlock(s, *board);
+  return isRegionCapacityDeadlock(s) || isMatchingDeadlocked(s) || isPatternDeadlocked(s);
+}
+
+bool SokobanHeuristics::isPatternDeadlocked(const State &s) const
+{
+  if (!board)
+    return false;
+
+  for (int i = 0; i < s.getBoxCount(); i++)
+  {
+    int pos = s.getBox(i).pos;
+    if (deadlockTable.matches(s.getBoxCells(), pos) || patterns.matches(s.getBoxCells(), pos))
+      return true;
+  }
+  return false;
+}
+
+bool SokobanHeuristics::isMatchingDeadlocked(const State &s) const
+{
+  int num_boxes = s.getBoxCount();
+  int num_goals = precomputed.getNumGoals();
+  if (!board || num_boxes == 0)
+    return false;
+  if (num_boxes > num_goals)
+    return true;
+
+  // Every box needs a goal of its own that it can be pushed to: the same
+  // matrix the assignment heuristic solves, with unreachable pairs as
+  // missing edges
+  buildCostMatrix(s, costScratch);
+  return matcher.solve(&costScratch[0], num_boxes, num_goals, UNREACHABLE_COST) < num_boxes;
 }
 
 bool SokobanHeuristics::is_multibox_deadlock(const State &state, const Board &board) const
@@ -778,11 +1112,8 @@ bool SokobanHeuristics::isCorridorDeadlock(const State &s) const
           visited[pos] = true;
 
           // Count boxes at this position
-          for (int b = 0; b < s.getBoxCount(); b++)
-          {
-            if (s.getBox(b).pos == pos)
-              boxes_in_corridor++;
-          }
+          if (s.hasBoxAt(pos))
+            boxes_in_corridor++;
 
           // Check for goals
           if (isGoalPosition[pos])
@@ -802,11 +1133,8 @@ bool SokobanHeuristics::isCorridorDeadlock(const State &s) const
           visited[pos] = true;
 
           // Count boxes at this position
-          for (int b = 0; b < s.getBoxCount(); b++)
-          {
-            if (s.getBox(b).pos == pos)
-              boxes_in_corridor++;
-          }
+          if (s.hasBoxAt(pos))
+            boxes_in_corridor++;
 
           // Check for goals
           if (isGoalPosition[pos])
@@ -911,251 +1239,204 @@ bool SokobanHeuristics::isRegionCapacityDeadlock(const State &s) const
   if (!board)
     return false;
 
-  int board_size = board->get_width() * board->get_height();
-  Array<bool> visited;
-
-  for (int i = 0; i < board_size; i++)
+  // Count boxes per static region against its goals, then put the
+  // scratch counts back to zero
+  bool deadlocked = false;
+  for (int i = 0; i < s.getBoxCount(); i++)
   {
-    visited.push_back(false);
+    int region = regionOf[s.getBox(i).pos];
+    if (region >= 0 && ++regionBoxes[region] > regionGoals[region])
+      deadlocked = true;
   }
-
-  // Check each unvisited passable cell
-  for (int pos = 0; pos < board_size; pos++)
+  for (int i = 0; i < s.getBoxCount(); i++)
   {
-    if (visited[pos] || board->is_wall_idx(pos))
-      continue;
-
-    // Flood fill to find connected region
-    Array<int> region;
-    int boxCount = 0;
-    int goalCount = 0;
-
-    floodFillRegionWithBoxes(pos, s, visited, region, boxCount, goalCount);
-
-    // Check if boxes exceed goals in this region
-    if (boxCount > goalCount)
-    {
-      return true; // More boxes than goals in isolated region
-    }
+    int region = regionOf[s.getBox(i).pos];
+    if (region >= 0)
+      regionBoxes[region] = 0;
   }
-
-  return false;
+  return deadlocked;
 }
 
-void SokobanHeuristics::floodFillRegion(int pos, Array<bool> &visited, Array<int> &region, int &boxCount, int &goalCount) const
+// ========== STAGE 4: Door-cycle Deadlock Detection ==========
+
+// Flood fill over (cell, step_mod_L), indexed cell * L + t. The player
+// takes one step per time slot into a cell whose door is open on arrival;
+// with a box in front, the push moves the box into a cell open at the next
+// slot and the player onto the box's old cell. Box cells are tracked
+// without time: a box may sit anywhere it has been pushed to for as long
+// as needed, so each newly reached box cell is tried against every slot
+// the player already reached beside it.
+void SokobanHeuristics::initializeReachability(const State &start)
 {
   if (!board)
     return;
 
   int width = board->get_width();
-  int height = board->get_height();
+  int board_size = width * board->get_height();
+  int L = board->getTimeModuloL();
 
-  Array<int> stack;
-  stack.push_back(pos);
+  playerReachable.clear();
+  boxReachable.clear();
 
-  while (!stack.empty())
+  Array<bool> visited;    // Player nodes, cell * L + t
+  Array<int> playerQueue; // Player nodes to expand
+  Array<int> boxQueue;    // Box cells to expand
+  for (int i = 0; i < board_size * L; i++)
   {
-    int current = stack[stack.getSize() - 1];
-    stack.pop_back();
-
-    if (visited[current] || board->is_wall_idx(current))
-      continue;
-
-    visited[current] = true;
-    region.push_back(current);
-
-    // Count goals in this cell
-    if (isGoalPosition[current])
-      goalCount++;
-
-    // Get coordinates
-    int row = current / width;
-    int col = current % width;
-
-    // Add neighbors to stack
-    int dr[] = {-1, 1, 0, 0};
-    int dc[] = {0, 0, -1, 1};
-
-    for (int dir = 0; dir < 4; dir++)
+    visited.push_back(false);
+    playerQueue.push_back(0);
+  }
+  for (int i = 0; i < board_size; i++)
+  {
+    boxQueue.push_back(0);
+  }
+  int playerHead = 0, playerTail = 0;
+  int boxHead = 0, boxTail = 0;
+
+  int startNode = start.getPlayerPos() * L + start.getStepModL() % L;
+  visited[startNode] = true;
+  playerQueue[playerTail++] = startNode;
+  playerReachable.set(start.getPlayerPos());
+  for (int i = 0; i < start.getBoxCount(); i++)
+  {
+    int pos = start.getBox(i).pos;
+    if (!boxReachable.test(pos))
     {
-      int new_row = row + dr[dir];
-      int new_col = col + dc[dir];
-
-      if (new_row >= 0 && new_row < height && new_col >= 0 && new_col < width)
-      {
-        int new_pos = new_row * width + new_col;
-        if (!visited[new_pos] && !board->is_wall_idx(new_pos))
-        {
-          stack.push_back(new_pos);
-        }
-      }
+      boxReachable.set(pos);
+      boxQueue[boxTail++] = pos;
     }
   }
-}
-
-void SokobanHeuristics::floodFillRegionWithBoxes(int pos, const State &state, Array<bool> &visited, Array<int> &region, int &boxCount, int &goalCount) const
-{
-  if (!board)
-    return;
 
-  int width = board->get_width();
-  int height = board->get_height();
-
-  Array<int> stack;
-  stack.push_back(pos);
-
-  while (!stack.empty())
+  while (playerHead < playerTail || boxHead < boxTail)
   {
-    int current = stack[stack.getSize() - 1];
-    stack.pop_back();
-
-    if (visited[current] || board->is_wall_idx(current))
-      continue;
+    // Walks and pushes from one player node
+    while (playerHead < playerTail)
+    {
+      int node = playerQueue[playerHead++];
+      int pos = node / L;
+      int next_t = (node % L + 1) % L;
+      int row = pos / width;
+      int col = pos % width;
 
-    visited[current] = true;
-    region.push_back(current);
+      for (int d = 0; d < 4; d++)
+      {
+        int r = row + pull_dr[d];
+        int c = col + pull_dc[d];
+        if (!isFloor(r, c))
+          continue;
+        int next = r * width + c;
 
-    // Count goals in this cell
-    if (isGoalPosition[current])
-      goalCount++;
+        if (board->is_open_idx(next, next_t) && !visited[next * L + next_t])
+        {
+          visited[next * L + next_t] = true;
+          playerQueue[playerTail++] = next * L + next_t;
+          playerReachable.set(next);
+        }
 
-    // Count boxes in this cell
-    for (int box_idx = 0; box_idx < state.getBoxCount(); box_idx++)
-    {
-      if (state.getBox(box_idx).pos == current)
-        boxCount++;
+        // A box on next goes one further, into a cell open at next_t
+        int dr2 = r + pull_dr[d];
+        int dc2 = c + pull_dc[d];
+        if (!boxReachable.test(next) || !isFloor(dr2, dc2))
+          continue;
+        int dest = dr2 * width + dc2;
+        if (!board->is_open_idx(dest, next_t))
+          continue;
+        if (!boxReachable.test(dest))
+        {
+          boxReachable.set(dest);
+          boxQueue[boxTail++] = dest;
+        }
+        if (!visited[next * L + next_t])
+        {
+          visited[next * L + next_t] = true;
+          playerQueue[playerTail++] = next * L + next_t;
+          playerReachable.set(next);
+        }
+      }
     }
 
-    // Get coordinates
-    int row = current / width;
-    int col = current % width;
-
-    // Add neighbors to stack
-    int dr[] = {-1, 1, 0, 0};
-    int dc[] = {0, 0, -1, 1};
-
-    for (int dir = 0; dir < 4; dir++)
+    // A new box cell can be pushed from any player node already beside it
+    while (boxHead < boxTail && playerHead == playerTail)
     {
-      int new_row = row + dr[dir];
-      int new_col = col + dc[dir];
-
-      if (new_row >= 0 && new_row < height && new_col >= 0 && new_col < width)
+      int pos = boxQueue[boxHead++];
+      int row = pos / width;
+      int col = pos % width;
+      for (int d = 0; d < 4; d++)
       {
-        int new_pos = new_row * width + new_col;
-        if (!visited[new_pos] && !board->is_wall_idx(new_pos))
+        if (!isFloor(row - pull_dr[d], col - pull_dc[d]) || !isFloor(row + pull_dr[d], col + pull_dc[d]))
+          continue;
+        int from = (row - pull_dr[d]) * width + col - pull_dc[d];
+        int dest = (row + pull_dr[d]) * width + col + pull_dc[d];
+        for (int t = 0; t < L; t++)
         {
-          stack.push_back(new_pos);
+          int next_t = (t + 1) % L;
+          if (!visited[from * L + t] || !board->is_open_idx(dest, next_t))
+            continue;
+          if (!boxReachable.test(dest))
+          {
+            boxReachable.set(dest);
+            boxQueue[boxTail++] = dest;
+          }
+          if (!visited[pos * L + next_t])
+          {
+            visited[pos * L + next_t] = true;
+            playerQueue[playerTail++] = pos * L + next_t;
+            playerReachable.set(pos);
+          }
         }
       }
     }
   }
-}
 
-// ========== STAGE 4: Door-cycle Deadlock Detection ==========
-
-bool SokobanHeuristics::isDoorCycleDeadlocked(const State &s, const Array<Door> &doors) const
-{
-  if (!board)
-    return false;
-
-  return is_door_cycle_deadlock(s, *board, doors);
+  reachabilityKnown = true;
+  precomputeDoorDeadSquares();
 }
 
-bool SokobanHeuristics::is_door_cycle_deadlock(const State &state, const Board &board, const Array<Door> &doors) const
+// A box can only end up on goals it has a push path to (ignoring doors)
+// and some box can reach (with doors): a cell where those never meet is dead
+void SokobanHeuristics::precomputeDoorDeadSquares()
 {
-  // Find unreachable goals due to permanently closed doors
-  Array<bool> unreachable;
-  int board_size = board.get_width() * board.get_height();
+  int board_size = board->get_width() * board->get_height();
+  int num_goals = precomputed.getNumGoals();
+  bool have_distances = precomputed.goalDist.getSize() == num_goals;
 
-  for (int i = 0; i < board_size; i++)
+  unreachableGoals.clear();
+  doorDeadSquares.clear();
+  if (!have_distances)
+    return;
+
+  for (int g = 0; g < num_goals; g++)
   {
-    unreachable.push_back(false);
+    int goal = precomputed.getGoalPosition(g);
+    if (!boxReachable.test(goal))
+      unreachableGoals.set(goal);
   }
 
-  findUnreachableGoals(doors, unreachable);
-
-  // Check if any box is assigned to an unreachable goal
-  for (int box_idx = 0; box_idx < state.getBoxCount(); box_idx++)
+  for (int pos = 0; pos < board_size; pos++)
   {
-    const BoxInfo &box = state.getBox(box_idx);
-    int box_pos = box.pos;
-
-    // For simplicity, we'll check if the box can only reach unreachable goals
-    bool has_reachable_goal = false;
-
-    for (int goal_idx = 0; goal_idx < precomputed.getNumGoals(); goal_idx++)
-    {
-      int goal_pos = precomputed.getGoalPosition(goal_idx);
-      if (!unreachable[goal_pos])
-      {
-        // Check if box can reach this reachable goal
-        int distance = precomputed.getDistance(goal_idx, box_pos);
-        if (distance != INT_MAX)
-        {
-          has_reachable_goal = true;
-          break;
-        }
-      }
-    }
-
-    if (!has_reachable_goal)
+    if (!boxReachable.test(pos) || deadSquares.test(pos))
+      continue;
+    bool reaches_goal = false;
+    for (int g = 0; g < num_goals && !reaches_goal; g++)
     {
-      return true; // Box can only reach unreachable goals
+      reaches_goal = !unreachableGoals.test(precomputed.getGoalPosition(g)) &&
+                     precomputed.getDistance(g, pos) != INT_MAX;
     }
+    if (!reaches_goal)
+      doorDeadSquares.set(pos);
   }
-
-  return false;
 }
 
-void SokobanHeuristics::findUnreachableGoals(const Array<Door> &doors, Array<bool> &unreachable) const
+bool SokobanHeuristics::isDoorCycleDeadlocked(const State &s) const
 {
   if (!board)
-    return;
-
-  // Mark goals as unreachable if they are behind permanently closed doors
-  for (int door_idx = 0; door_idx < doors.getSize(); door_idx++)
-  {
-    const Door &door = doors[door_idx];
-
-    // If openTime == 0, door is permanently closed
-    if (door.openTime == 0)
-    {
-      // Find all goals that are only accessible through this door
-      // This is a simplified implementation - a full implementation would
-      // require complex reachability analysis
-
-      int width = board->get_width();
-      int height = board->get_height();
-
-      // Find door positions on the board
-      for (int pos = 0; pos < width * height; pos++)
-      {
-        if (board->get_door_id_idx(pos) == door.id)
-        {
-          // This is a simplified approach: mark adjacent goals as unreachable
-          // A full implementation would do flood-fill to find isolated regions
-          int row = pos / width;
-          int col = pos % width;
+    return false;
 
-          int dr[] = {-1, 1, 0, 0};
-          int dc[] = {0, 0, -1, 1};
+  // Stage 4: any box on a cell whose goals no box can ever reach
+  return s.getBoxCells().intersects(doorDeadSquares);
+}
 
-          for (int dir = 0; dir < 4; dir++)
-          {
-            int new_row = row + dr[dir];
-            int new_col = col + dc[dir];
-
-            if (new_row >= 0 && new_row < height && new_col >= 0 && new_col < width)
-            {
-              int adj_pos = new_row * width + new_col;
-              if (isGoalPosition[adj_pos])
-              {
-                unreachable[adj_pos] = true;
-              }
-            }
-          }
-        }
-      }
-    }
-  }
-}
\ No newline at end of file
+bool SokobanHeuristics::isDoorCycleDeadlocked(const State &s, const Array<Door> & /*doors*/) const
+{
+  return isDoorCycleDeadlocked(s);
+}
@@ -3,6 +3,10 @@
 #include "Array.h"
 #include "Board.h"
 #include "State.h"
+#include "AssignmentSolver.h"
+#include "BipartiteMatcher.h"
+#include "DeadlockPatterns.h"
+#include "PatternTable.h"
 #include <queue>
 #include <climits>
 
@@ -25,32 +29,123 @@ class SokobanHeuristics
 private:
   const Board *board;
 
-  // Precomputed BFS distances from each goal to all cells
+  // Precomputed push distances from each goal to all cells (reverse pulls)
   PrecomputedDistances precomputed;
 
+  // sideRegion[cell * 4 + dir]: which neighbours of a box on cell the player
+  // can walk between (box as the only obstacle). Sides with the same label
+  // are connected; NO_SIDE marks a neighbour that is a wall or off the board.
+  static const uint8_t NO_SIDE = 0xFF;
+  Array<uint8_t> sideRegion;
+
   // Precomputed corner deadlock detection
   Array<bool> isCorner;       // isCorner[cell]
   Array<bool> isGoalPosition; // Quick lookup: isGoalPosition[cell]
 
+  // Simple deadlocks, fixed per board: a box on one of these cells can
+  // never be pushed to any goal
+  CellBitset deadCorners; // Non-goal corners (stage 1)
+  CellBitset deadSquares; // Non-goal cells no goal pulls back to (stage 2, includes corners)
+
+  // Static regions: floor cells connected without crossing walls or doors
+  // that never open. A push never leaves its region, so each region's box
+  // count is fixed unless a box crosses into another one.
+  Array<int> regionOf;            // Region id per cell, -1 for walls
+  Array<int> regionGoals;         // Goals per region
+  mutable Array<int> regionBoxes; // Scratch box counts, all zero between calls
+
+  // Door-aware reachability from the level's start, filled by
+  // initializeReachability over (cell, step_mod_L). Box-box blocking and
+  // keys are ignored, so the reachable sets only ever over-approximate.
+  bool reachabilityKnown;
+  CellBitset playerReachable;   // Cells the player can ever stand on
+  CellBitset boxReachable;      // Cells some box can ever be pushed onto
+  CellBitset unreachableGoals;  // Goals no box can ever be pushed onto
+  CellBitset doorDeadSquares;   // Cells whose goals (by push distance) are all unreachable (stage 4)
+
+  // Box patterns proven dead during search; they depend on the board only,
+  // so they outlive a solve
+  mutable DeadlockPatterns patterns;
+
+  // 3x3 blocks proven dead offline (genPatternTable), loaded on first use
+  PatternTable deadlockTable;
+
+  // Box-to-goal assignment solver (working arrays reused across calls)
+  mutable AssignmentSolver assignment;
+  mutable Array<int> costScratch; // Flat boxes x goals matrix, grown once and reused
+  mutable BipartiteMatcher matcher; // Box-to-reachable-goal matching (stage 3)
+
+  // Parent kept by setParent for incremental child heuristics
+  bool parentValid;              // Parent has a square box/goal matrix
+  int parentH;                   // Parent's assignment cost
+  int parentBoxCount;            // Rows in use in parentBoxes / parentCost
+  Array<int> parentBoxes;        // Parent box positions, one per cost row
+  CellBitset parentCells;        // Parent box occupancy
+  mutable Array<int> parentCost; // Parent cost matrix (one row patched per child)
+  mutable Array<int> savedRow;   // Parent row overwritten by a child
+
 public:
+  // Cost of a box-goal pair with no push path. The assignment bound reaches
+  // it exactly when no matching gives every box a goal of its own.
+  static const int UNREACHABLE_COST = 999999;
+
   SokobanHeuristics();
   ~SokobanHeuristics() = default;
 
   // Initialize heuristics with board
   void initialize(const Board &b);
 
+  // Door-aware reachability for one level (stage 4). Floods the time
+  // expanded graph from the start's player cell and step, pushing boxes
+  // from their start cells; call after initialize() and before search.
+  // Without it stage 4 finds nothing.
+  void initializeReachability(const State &start);
+
   // Heuristic functions
   int heuristic(const State &s) const;        // Uses Hungarian assignment
   int heuristic_simple(const State &s) const; // Original sum of minimums
   int heuristic_assignment(const State &s, const Board &board, const PrecomputedDistances &precomp) const;
 
+  // Incremental assignment across one push: setParent solves the expanded
+  // state and keeps its potentials and matching; heuristicFromParent then
+  // bounds a child whose boxes differ in one position by repairing that
+  // row, O(n^2) instead of O(n^3). Other children fall back to heuristic().
+  void setParent(const State &parent);
+  int heuristicFromParent(const State &child) const;
+
   // Deadlock detection (All 4 Stages)
   bool isDeadlocked(const State &s) const;
   bool isDeadlocked(const State &s, const Array<Door> &doors) const;          // With door information
   bool isCornerDeadlocked(const State &s) const;                              // Stage 1
   bool isWallDeadlocked(const State &s) const;                                // Stage 2
   bool isMultiboxDeadlocked(const State &s) const;                            // Stage 3
-  bool isDoorCycleDeadlocked(const State &s, const Array<Door> &doors) const; // Stage 4
+  bool isMatchingDeadlocked(const State &s) const;                            // Stage 3: no box-goal matching
+  bool isPatternDeadlocked(const State &s) const;                             // Stage 3: table and learned patterns
+  bool isDoorCycleDeadlocked(const State &s) const;                           // Stage 4
+  bool isDoorCycleDeadlocked(const State &s, const Array<Door> &doors) const; // Same; doors come from the board schedule
+
+  // Hot-path check for a state produced by one push (action U/D/L/R; the
+  // pushed box is next to the player in that direction). Only the pushed
+  // box and the boxes it leans on are examined: a dead square test, the
+  // blocks around it, then a freeze test. Any other state returns false,
+  // since no box moved.
+  bool isPushDeadlocked(const State &s) const;
+
+  // Learn from a state all of whose children are dead: try to prove the
+  // boxes around the pushed one dead and store the pattern. True if stored.
+  bool learnDeadlock(const State &s);
+
+  // The pushed box cannot be pushed along either axis until another box
+  // moves (a cheap filter for states worth learning from)
+  bool isPushedBoxStuck(const State &s) const;
+  const DeadlockPatterns &getPatterns() const { return patterns; }
+  void resetPatternCounters() { patterns.resetCounters(); }
+  const PatternTable &getDeadlockTable() const { return deadlockTable; }
+
+  // Freeze deadlock: the box on pos can never move again (each axis blocked
+  // by a wall, by dead squares on both sides, or by another frozen box) and
+  // it, or a box frozen with it, is not a finished box on a goal
+  bool isFreezeDeadlocked(const State &s, int pos) const;
 
   // Debug methods
   void printGoalDistances() const;
@@ -58,6 +153,11 @@ public:
 
   // Access precomputed data
   const PrecomputedDistances &getPrecomputedDistances() const { return precomputed; }
+  const CellBitset &getDeadSquares() const { return deadSquares; }
+  bool isDeadSquare(int pos) const { return deadSquares.test(pos); }
+  bool isPlayerReachable(int pos) const { return !reachabilityKnown || playerReachable.test(pos); }
+  bool isBoxReachable(int pos) const { return !reachabilityKnown || boxReachable.test(pos); }
+  const CellBitset &getUnreachableGoals() const { return unreachableGoals; }
 
   // Test accessors (for testing individual stages)
   bool test_isCorridorDeadlock(const State &s) const { return isCorridorDeadlock(s); }
@@ -67,12 +167,29 @@ private:
   // Helper methods for initialization
   void precomputeGoalDistances();
   void precomputeCorners();
-  void runBFSFromGoal(int goalIndex, int goalPos);
+  void precomputeDeadSquares();
+  void precomputeRegions();
+  bool isStaticFloor(int pos) const;
+  void precomputeSideRegions();
+  void runPullBFSFromGoal(int goalIndex, int goalPos);
+  bool isFloor(int row, int col) const;
   bool isCellCorner(int pos) const;
 
+  // Cell of the box the last push moved, -1 for key pickups and the root
+  int pushedBoxPos(const State &s) const;
+
+  // Freeze deadlock helpers; boxes on the recursion stack count as walls
+  mutable CellBitset freezeStack;
+  bool isFrozenBox(const State &s, int pos, bool &offGoal) const;
+  bool isAxisBlocked(const State &s, int pos, int step, bool &offGoal) const;
+
+  // Push cost from a cell to a goal, UNREACHABLE_COST when no push path exists
+  // or no box can reach the goal at all
+  int pushCost(int goalIndex, int pos) const;
+
   // Hungarian algorithm implementation
-  int hungarianAlgorithm(const Array<Array<int>> &costMatrix, int n, int m) const;
-  void buildCostMatrix(const State &s, Array<Array<int>> &costMatrix) const;
+  int hungarianAlgorithm(const Array<int> &costMatrix, int n, int m) const;
+  void buildCostMatrix(const State &s, Array<int> &costMatrix) const; // Flat, row-major boxes x goals; reuses capacity
 
   // Wall deadlock detection helpers
   bool isWallDeadlock(const State &s) const;
@@ -83,11 +200,8 @@ private:
   bool is_multibox_deadlock(const State &state, const Board &board) const;
   bool isCorridorDeadlock(const State &s) const;
   bool isRegionCapacityDeadlock(const State &s) const;
-  void floodFillRegion(int pos, Array<bool> &visited, Array<int> &region, int &boxCount, int &goalCount) const;
-  void floodFillRegionWithBoxes(int pos, const State &state, Array<bool> &visited, Array<int> &region, int &boxCount, int &goalCount) const;
   bool isCorridor(int pos, int &corridorStart, int &corridorEnd, int &direction) const;
 
   // Door-cycle deadlock detection (Stage 4)
-  bool is_door_cycle_deadlock(const State &state, const Board &board, const Array<Door> &doors) const;
-  void findUnreachableGoals(const Array<Door> &doors, Array<bool> &unreachable) const;
+  void precomputeDoorDeadSquares();
 };
\ No newline at end of file
@@ -2,22 +2,32 @@
 #include "Simulation.h"
 #include "PlayerPathfinder.h"
 #include <iostream>
+#include <cstring>
 
 SolverAStar::SolverAStar(const Board &board, const Array<Door> &doors, const Meta &meta, Zobrist &zobrist)
-    : board(board), doors(doors), meta(meta), zobrist(zobrist), closedSet(), openSet()
+    : board(board), doors(doors), meta(meta), zobrist(zobrist),
+      openSet(OpenList::create(OPEN_LIST_BUCKET)), openListType(OPEN_LIST_BUCKET), nodes(), states(), transpositions(states),
+      expansionLimit(1000000), normalizePlayer(false)
 {
 
   // Initialize heuristics with the board
   heuristics.initialize(board);
+
+  // One pathfinder serves every expansion
+  pathfinder.initialize(board, doors);
 }
 
 SolverAStar::~SolverAStar()
 {
-  // Clean up allocated nodes
-  for (int i = 0; i < allNodes.getSize(); i++)
-  {
-    delete allNodes[i];
-  }
+  // NodeArena releases any remaining nodes
+  delete openSet;
+}
+
+void SolverAStar::setOpenListType(OpenListType type)
+{
+  delete openSet;
+  openSet = OpenList::create(type);
+  openListType = type;
 }
 
 bool SolverAStar::solve(const InitialDynamicState &init, Array<char> &outMoves, SolverStats &stats)
@@ -30,18 +40,10 @@ bool SolverAStar::solve(const InitialDynamicState &init, Array<char> &outMoves,
   currentStats = SolverStats();
   startTime = std::chrono::steady_clock::now();
 
-  // Clear data structures
-  closedSet.clear();
-  // Clear previous node storage
-  for (int i = 0; i < allNodes.getSize(); i++)
-  {
-    delete allNodes[i];
-  }
-  while (allNodes.getSize() > 0)
-  {
-    allNodes.pop_back();
-  }
-  // Note: BinaryHeap doesn't have clear(), we'll create a new one if needed
+  // Clear data structures (open entries and the table refer to arena ids)
+  transpositions.clear();
+  openSet->clear();
+  nodes.clear();
 
   // Compute L = board.getTimeModuloL() for state creation
   int L = board.getTimeModuloL();
@@ -75,102 +77,84 @@ bool SolverAStar::solve(const InitialDynamicState &init, Array<char> &outMoves,
   // Canonicalize and compute hash
   initialState.canonicalize();
   initialState.recompute_hash(zobrist);
+  if (normalizePlayer)
+  {
+    normalizePlayerPos(initialState);
+  }
 
-  // Initial state created
+  // Door reachability is fixed by where the level starts; learned
+  // patterns carry over, their counters start again
+  heuristics.initializeReachability(initialState);
+  heuristics.resetPatternCounters();
 
   // Compute initial heuristic
   int h_initial = heuristics.heuristic(initialState);
 
-  // Create and store initial node
-  AStarNode *initialNodePtr = new AStarNode(initialState, 0, h_initial, nullptr);
-  allNodes.push_back(initialNodePtr);
-  openSet.push(*initialNodePtr);
-  currentStats.nodesGenerated++;
+  // Fix the packed layout for this level, then create and store the initial node
+  packer.initialize(initialState, normalizePlayer);
+  states.reset(packer.getRecordSize(), packer.getKeySize());
+  while (packScratch.getSize() < packer.getRecordSize())
+  {
+    packScratch.push_back(0);
+  }
+  packer.pack(initialState, &packScratch[0]);
+  uint32_t rootId = addNode(initialState, 0, h_initial, NodeArena<AStarNode>::NO_NODE);
+
+  // Successors are only checked around the pushed box, which relies on
+  // the boxes that did not move being deadlock-free: check the root fully
+  bool rootDeadlocked = heuristics.isDeadlocked(initialState);
+
+  bool solved = false;
 
   // Main A* loop
-  while (!openSet.isEmpty())
+  while (!openSet->isEmpty())
   {
     // Update peak open size
-    if (openSet.getSize() > currentStats.peakOpenSize)
+    if (openSet->getSize() > currentStats.peakOpenSize)
     {
-      currentStats.peakOpenSize = openSet.getSize();
+      currentStats.peakOpenSize = openSet->getSize();
     }
 
     // Get node with lowest f-cost
-    AStarNode current = openSet.pop();
+    OpenEntry entry = openSet->pop();
+    const AStarNode &current = nodes.get(entry.id);
 
-    // Check if already in closed set with better cost
-    uint64_t stateHash = current.state.hash();
-    auto it = closedSet.find(stateHash);
-    if (it != closedSet.end() && it->second <= current.g)
+    // Skip stale entries: a cheaper node for this state was generated later
+    uint32_t bestId;
+    int bestG;
+    if (transpositions.find(current.hash, states.get(entry.id), bestId, bestG) && bestId != entry.id)
     {
-      continue; // Skip this node - we've seen this state with better cost
+      continue;
     }
 
+    // Unpack the state; the hash and energy come from the node
+    State currentState;
+    packer.unpack(states.get(entry.id), currentState);
+    currentState.setZobristHash(current.hash);
+    currentState.setEnergyUsed(current.g);
+
     // Check if goal state
-    if (isGoal(current.state))
+    if (isGoal(currentState))
     {
       std::cout << "Goal found!" << std::endl;
-      std::cout << "Goal state: player at " << current.state.getPlayerPos() 
+      std::cout << "Goal state: player at " << currentState.getPlayerPos() 
                 << ", boxes: ";
-      for (int i = 0; i < current.state.getBoxCount(); i++)
+      for (int i = 0; i < currentState.getBoxCount(); i++)
       {
-        std::cout << current.state.getBox(i).pos << " ";
+        std::cout << currentState.getBox(i).pos << " ";
       }
       std::cout << std::endl;
 
-      // Find the actual node pointer for this state (need to search allNodes)
-      AStarNode *goalNodePtr = nullptr;
-      for (int i = 0; i < allNodes.getSize(); i++)
-      {
-        if (allNodes[i]->state.equals(current.state))
-        {
-          goalNodePtr = allNodes[i];
-          break;
-        }
-      }
-
-      if (goalNodePtr)
-      {
-        // Use Simulation's reconstruct_moves function
-        Simulation::reconstruct_moves(goalNodePtr, outMoves);
-      }
-      else
-      {
-        // Could not find goal node pointer
-      }
+      // Walk parent ids from the popped entry's handle, recomputing the walks
+      Simulation::reconstruct_moves(board, doors, nodes, states, packer, entry.id, outMoves);
 
       currentStats.solutionCost = current.g;
-      updateStats();
-      stats = currentStats;
-      return true;
+      solved = true;
+      break;
     }
 
-    // Add to closed set
-    closedSet[stateHash] = current.g;
     currentStats.nodesExpanded++;
 
-    // Find current node pointer in allNodes
-    AStarNode *currentNodePtr = nullptr;
-    for (int i = 0; i < allNodes.getSize(); i++)
-    {
-      if (allNodes[i]->state.equals(current.state))
-      {
-        currentNodePtr = allNodes[i];
-        break;
-      }
-    }
-
-    if (!currentNodePtr)
-    {
-      // Could not find current node pointer
-      continue;
-    }
-
-    // Generate successors with move tracking
-    Array<AStarNode *> successorNodes;
-    generateSuccessorsWithMoves(currentNodePtr, successorNodes);
-
     // Only show progress every 50000 nodes
     if (currentStats.nodesExpanded % 50000 == 0)
     {
@@ -178,65 +162,36 @@ bool SolverAStar::solve(const InitialDynamicState &init, Array<char> &outMoves,
     }
 
     // Stop if we've expanded too many nodes (increased limit for complex puzzles)
-    if (currentStats.nodesExpanded > 1000000)
+    if (currentStats.nodesExpanded > expansionLimit)
     {
-      std::cout << "Search limit reached (1,000,000 nodes)" << std::endl;
+      std::cout << "Search limit reached (" << expansionLimit << " nodes)" << std::endl;
       break;
     }
 
-    // Process each successor
-    for (int i = 0; i < successorNodes.getSize(); i++)
+    // A deadlocked root has no successors worth keeping
+    if (entry.id == rootId && rootDeadlocked)
     {
-      AStarNode *successorNode = successorNodes[i];
-
-      // Enable deadlock detection to prune dead-end states
-      if (heuristics.isDeadlocked(successorNode->state))
-      {
-        // Deadlocked state - skip it
-        delete successorNode;
-        continue;
-      }
-
-      // Check energy limit
-      if (successorNode->state.getEnergyUsed() > meta.energyLimit)
-      {
-        // Energy limit exceeded
-        delete successorNode;
-        continue;
-      }
-
-      // Recompute hash for successor
-      successorNode->state.recompute_hash(zobrist);
+      continue;
+    }
 
-      // Compute costs
-      int g_new = successorNode->state.getEnergyUsed(); // Use total energy as g-cost
-      int h_new = heuristics.heuristic(successorNode->state);
-      successorNode->g = g_new;
-      successorNode->h = h_new;
-      successorNode->f = g_new + h_new;
+    // Generate successors and add the surviving ones to the open set
+    expandNode(entry.id, currentState);
+  }
 
-      // Check if already in closed set with better cost
-      uint64_t succHash = successorNode->state.hash();
-      auto closedIt = closedSet.find(succHash);
-      if (closedIt != closedSet.end() && closedIt->second <= g_new)
-      {
-        // Already in closed set with better cost
-        delete successorNode;
-        continue; // Skip - already processed with better cost
-      }
+  // Free the whole search in one shot
+  openSet->clear();
+  transpositions.clear();
+  nodes.clear();
+  states.reset(0);
 
-      // Store node and add to open set
-      allNodes.push_back(successorNode);
-      openSet.push(*successorNode);
-      currentStats.nodesGenerated++;
-      // Added to open set
-    }
-  }
+  const DeadlockPatterns &patterns = heuristics.getPatterns();
+  currentStats.patternsLearned = patterns.getPatternCount();
+  currentStats.patternLookups = patterns.getLookups();
+  currentStats.patternHits = patterns.getHits();
 
-  // No solution found
   updateStats();
   stats = currentStats;
-  return false;
+  return solved;
 }
 
 bool SolverAStar::isGoal(const State &state) const
@@ -254,34 +209,6 @@ bool SolverAStar::isGoal(const State &state) const
   return true;
 }
 
-void SolverAStar::reconstructPath(const AStarNode &goalNode, Array<char> &outMoves) const
-{
-  // This is a simplified reconstruction - in a full implementation,
-  // we would need to track the actual moves that led to each state.
-  // For now, we'll use the successor generator to find the moves between states.
-
-  Array<const State *> statePath;
-  const State *current = &goalNode.state;
-
-  // Build path from goal to start
-  while (current != nullptr)
-  {
-    statePath.push_back(current);
-
-    // Find parent state in the path (simplified approach)
-    // In a full implementation, we'd store parent pointers properly
-    current = nullptr; // Break for now - would need proper parent tracking
-    break;
-  }
-
-  // For now, return empty moves array
-  // A full implementation would reconstruct the actual move sequence
-  while (outMoves.getSize() > 0)
-  {
-    outMoves.pop_back();
-  }
-}
-
 int SolverAStar::computeMoveCost(const State &from, const State &to) const
 {
   // Simple cost model - use difference in energy
@@ -295,123 +222,112 @@ void SolverAStar::updateStats()
   currentStats.elapsedMs = duration.count();
 }
 
-void SolverAStar::generateSuccessorsWithMoves(const AStarNode *parentNode, Array<AStarNode *> &successorNodes)
+void SolverAStar::expandNode(uint32_t nodeId, const State &currentState)
 {
-  const State &currentState = parentNode->state;
-
   // Use the proper successor generator that only generates box pushes
-  Array<State> successors = generateSuccessors(currentState, board, doors, meta);
-
-  // Create pathfinder to reconstruct the full move sequences
-  // The pathfinder needs to avoid box positions
-  Array<int> boxPositions;
-  for (int i = 0; i < currentState.getBoxCount(); i++)
-  {
-    boxPositions.push_back(currentState.getBox(i).pos);
-  }
-
-  PlayerPathfinder pathfinder;
-  pathfinder.initialize(board, doors);
-  pathfinder.setBlockedPositions(boxPositions);
-  pathfinder.findPaths(currentState.getPlayerPos(), currentState.getStepModL());
-
-  // Direction vectors for movement: up, down, left, right
-  static const int dr[] = {-1, 1, 0, 0};
-  static const int dc[] = {0, 0, -1, 1};
-  static const char moves[] = {'U', 'D', 'L', 'R'};
+  // (hashes are updated incrementally from the parent's; pushes onto dead
+  // squares are never created)
+  Array<State> successors = generateSuccessors(currentState, board, doors, meta, pathfinder, &zobrist,
+                                               &heuristics.getDeadSquares());
 
-  int cols = board.get_width();
+  // Children differ from this state by one push: their assignment bounds
+  // are repaired from this state's solution
+  heuristics.setParent(currentState);
 
-  // Convert State objects to AStarNode pointers
+  // Process each successor
+  int liveChildren = 0;
   for (int i = 0; i < successors.getSize(); i++)
   {
-    AStarNode *successorNode = new AStarNode();
-    successorNode->state = successors[i];
-    successorNode->parent = reinterpret_cast<State *>(const_cast<AStarNode *>(parentNode));
-    
-    // Get the full move sequence: player path + push direction
-    // The successor state has the player at the box's original position after pushing
-    // We need to find where the player was BEFORE the push to get the correct path
-    
-    // Get the push direction
-    char pushDirection = successors[i].getActionFromParent();
-    
-    // Handle key pickup action separately
-    if (pushDirection == 'K')
+    State &succ = successors[i];
+
+    // Prune dead ends; only the pushed box can have created a new deadlock
+    if (heuristics.isPushDeadlocked(succ))
+    {
+      continue; // Deadlocked state - skip it
+    }
+
+    // A pushed box that cannot move until others do may sit in a dead
+    // pattern not seen before; a proven one prunes this child too
+    if (heuristics.isPushedBoxStuck(succ) && heuristics.learnDeadlock(succ))
     {
-      // Key pickup action - player moves to key position
-      // Get the path from current player position to the key position
-      int keyPos = successors[i].getPlayerPos();
-      Array<char> pathMoves = pathfinder.getPath(keyPos);
-      
-      // Add all path moves to actionsFromParent
-      for (int j = 0; j < pathMoves.getSize(); j++)
-      {
-        successorNode->actionsFromParent.push_back(pathMoves[j]);
-      }
-      
-      successorNode->g = computeMoveCost(currentState, successors[i]);
-      successorNode->h = heuristics.heuristic(successors[i]);
-      successorNodes.push_back(successorNode);
-      currentStats.nodesGenerated++;
       continue;
     }
-    
-    // Find which direction index this corresponds to
-    int dirIndex = -1;
-    for (int d = 0; d < 4; d++)
+
+    // Check energy limit
+    if (succ.getEnergyUsed() > meta.energyLimit)
     {
-      if (moves[d] == pushDirection)
-      {
-        dirIndex = d;
-        break;
-      }
+      continue; // Energy limit exceeded
     }
-    
-    if (dirIndex == -1)
+    liveChildren++;
+
+    if (normalizePlayer)
     {
-      // No push direction stored, skip this successor
-      delete successorNode;
-      continue;
+      normalizePlayerPos(succ);
     }
-    
-    // Calculate where the player needed to be to make this push
-    // The new player position is where the box was
-    int boxOldPos = successors[i].getPlayerPos();
-    int boxOldRow = boxOldPos / cols;
-    int boxOldCol = boxOldPos % cols;
-    
-    // Player was on the opposite side of the push direction
-    int playerTargetRow = boxOldRow - dr[dirIndex];
-    int playerTargetCol = boxOldCol - dc[dirIndex];
-    int playerTarget = playerTargetRow * cols + playerTargetCol;
-    
-    // Get the path from current player position to the push position
-    Array<char> pathMoves = pathfinder.getPath(playerTarget);
-    
-    // DEBUG
-    if (false && successors[i].getBox(0).pos == 18) {  // If this leads to goal
-      std::cout << "DEBUG: Generating successor that leads to goal (box at 18)" << std::endl;
-      std::cout << "  Parent player pos: " << currentState.getPlayerPos() << std::endl;
-      std::cout << "  Push direction: " << pushDirection << std::endl;
-      std::cout << "  Box old pos: " << boxOldPos << std::endl;
-      std::cout << "  Player target pos: " << playerTarget << std::endl;
-      std::cout << "  Path: ";
-      for (int j = 0; j < pathMoves.getSize(); j++) {
-        std::cout << pathMoves[j];
-      }
-      std::cout << std::endl;
+
+    // Compute costs
+    int g_new = succ.getEnergyUsed(); // Use total energy as g-cost
+
+    // Skip states already reached (open or expanded) at no greater cost
+    packer.pack(succ, &packScratch[0]);
+    uint32_t seenId;
+    int seenG;
+    if (transpositions.find(succ.hash(), &packScratch[0], seenId, seenG) && seenG <= g_new)
+    {
+      continue;
     }
-    
-    // Add all path moves to actionsFromParent
-    for (int j = 0; j < pathMoves.getSize(); j++)
+
+    // The exact assignment bound only reaches UNREACHABLE_COST when the
+    // boxes have no matching onto distinct reachable goals
+    int h_new = heuristics.heuristicFromParent(succ);
+    if (h_new >= SokobanHeuristics::UNREACHABLE_COST)
     {
-      successorNode->actionsFromParent.push_back(pathMoves[j]);
+      continue;
     }
-    
-    // Add the push direction
-    successorNode->actionsFromParent.push_back(pushDirection);
-    
-    successorNodes.push_back(successorNode);
+
+    addNode(succ, g_new, h_new, nodeId);
+  }
+
+  // Every push from here is dead: a candidate pattern around the box this
+  // state pushed last (stored only if a local search proves it)
+  if (liveChildren == 0)
+  {
+    heuristics.learnDeadlock(currentState);
   }
-}
\ No newline at end of file
+}
+
+void SolverAStar::normalizePlayerPos(State &state)
+{
+  pathfinder.setBlockedCells(state.getBoxCells());
+  int canonical = pathfinder.minReachableCell(state.getPlayerPos(), state.getStepModL());
+  if (canonical == state.getCanonicalPlayerPos())
+    return;
+
+  // Hash delta: swap the player term
+  uint64_t h = state.hash();
+  h ^= zobrist.player_hash(state.getCanonicalPlayerPos()) ^ zobrist.player_hash(canonical);
+  state.setZobristHash(h);
+  state.setCanonicalPlayerPos(canonical);
+}
+
+uint32_t SolverAStar::addNode(const State &state, int g, int h, uint32_t parent)
+{
+  // Node and packed state share one id
+  uint32_t id = nodes.allocate();
+  states.allocate();
+  memcpy(states.get(id), &packScratch[0], packer.getRecordSize());
+
+  AStarNode &node = nodes.get(id);
+  node.hash = state.hash();
+  node.g = g;
+  node.h = h;
+  node.f = g + h;
+  node.id = id;
+  node.parent = parent;
+  node.action = state.getActionFromParent();
+  transpositions.update(id, node.hash, g);
+
+  openSet->push(OpenEntry(node.f, node.h, id));
+  currentStats.nodesGenerated++;
+  return id;
+}
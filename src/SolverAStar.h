@@ -8,53 +8,33 @@
 #include "Meta.h"
 #include "Zobrist.h"
 #include "BinaryHeap.h"
+#include "OpenList.h"
 #include "HashTable.h"
+#include "NodeArena.h"
+#include "PackedState.h"
+#include "TranspositionTable.h"
 #include "SokobanHeuristics.h"
 #include "SuccessorGenerator.h"
+#include "PlayerPathfinder.h"
 #include "ConfigParser.h"
 #include "SolverStats.h"
 #include <chrono>
-#include <unordered_map>
 
-// A* search node containing state and cost information
+// A* search node containing cost information and links.
+// The node's state is kept packed in the solver's PackedStatePool under the
+// same id; energy used equals g. Only the push is recorded: the player walk
+// leading to it is recomputed for solution nodes by Simulation::reconstruct_moves.
 struct AStarNode
 {
-  State state;
+  uint64_t hash; // Zobrist hash of the node's state
   int g; // Cost from start
   int h; // Heuristic cost to goal
   int f; // Total cost (g + h)
-  State *parent;
-  Array<char> actionsFromParent;
-
-  AStarNode() : g(0), h(0), f(0), parent(nullptr) {}
-
-  AStarNode(const State &s, int g_cost, int h_cost, State *p = nullptr)
-      : state(s), g(g_cost), h(h_cost), f(g_cost + h_cost), parent(p) {}
-
-  // Comparison for BinaryHeap (min-heap by f, tie-break by h)
-  bool operator<(const AStarNode &other) const
-  {
-    if (f != other.f)
-    {
-      return f < other.f; // Smaller f has higher priority
-    }
-    return h < other.h; // Tie-break by smaller h
-  }
-
-  bool operator>(const AStarNode &other) const
-  {
-    return other < *this;
-  }
-
-  bool operator<=(const AStarNode &other) const
-  {
-    return !(*this > other);
-  }
-
-  bool operator>=(const AStarNode &other) const
-  {
-    return !(*this < other);
-  }
+  uint32_t id;     // Handle into the solver's node arena
+  uint32_t parent; // Parent node id (NodeArena::NO_NODE for the root)
+  char action;     // Push direction ('U','D','L','R'), 'K' for a key pickup, 0 at the root
+
+  AStarNode() : hash(0), g(0), h(0), f(0), id(NodeArena<AStarNode>::NO_NODE), parent(NodeArena<AStarNode>::NO_NODE), action(0) {}
 };
 
 class SolverAStar
@@ -67,25 +47,46 @@ private:
 
   SokobanHeuristics heuristics;
 
-  // Hash table for closed set: maps state hash to best g-cost
-  std::unordered_map<uint64_t, int> closedSet;
+  // Player reachability for the node being expanded
+  PlayerPathfinder pathfinder;
+
+  // Open set of compact entries (binary heap or bucket queue)
+  OpenList *openSet;
+  OpenListType openListType;
+
+  // Arena owning every node of the current search (indexed by AStarNode::id)
+  NodeArena<AStarNode> nodes;
+
+  // Packed node states (record id == node id) and the level's packing layout
+  StatePacker packer;
+  PackedStatePool states;
+  Array<uint8_t> packScratch; // Packed successor awaiting the duplicate check
+
+  // Every state reached so far: best g and the node holding it
+  TranspositionTable transpositions;
 
-  // Open set implemented as binary heap
-  BinaryHeap<AStarNode> openSet;
+  // Maximum number of expansions before the search gives up
+  int expansionLimit;
 
-  // Node storage to maintain valid parent pointers
-  Array<AStarNode *> allNodes;
+  // Identify states by the player's reachable area instead of the exact cell
+  bool normalizePlayer;
 
   // Statistics tracking
   SolverStats currentStats;
   std::chrono::steady_clock::time_point startTime;
 
-  // Helper function to generate successors with move sequences
-  void generateSuccessorsWithMoves(const AStarNode *parentNode, Array<AStarNode *> &successorNodes);
+  // Expand a node: generate, filter and store its successors in the open set
+  void expandNode(uint32_t nodeId, const State &currentState);
+
+  // Replace the player's cell in the state's identity (and hash) with the
+  // smallest cell it can reach
+  void normalizePlayerPos(State &state);
+
+  // Store a new node for `state` (already packed into packScratch) and return its id
+  uint32_t addNode(const State &state, int g, int h, uint32_t parent);
 
   // Helper methods
   bool isGoal(const State &state) const;
-  void reconstructPath(const AStarNode &goalNode, Array<char> &outMoves) const;
   int computeMoveCost(const State &from, const State &to) const;
   void updateStats();
 
@@ -96,11 +97,32 @@ public:
   // Destructor
   ~SolverAStar();
 
+  // The solver owns its open list, so copying is not allowed
+  SolverAStar(const SolverAStar &) = delete;
+  SolverAStar &operator=(const SolverAStar &) = delete;
+
   // Main solving method
   bool solve(const InitialDynamicState &init, Array<char> &outMoves, SolverStats &stats);
 
   // Utility methods for testing
   const SolverStats &getLastStats() const { return currentStats; }
+
+  // Search limit (default 1,000,000 expansions)
+  void setExpansionLimit(int limit) { expansionLimit = limit; }
+  int getExpansionLimit() const { return expansionLimit; }
+
+  // Player normalization (default off). States differing only in where the
+  // player stands inside one reachable area are merged; the cheaper one is
+  // kept and its true position drives later costs. Shrinks the closed set on
+  // open levels, but solutions are no longer guaranteed energy-optimal (and
+  // tight energy limits can cut off a solution); on door levels the area is
+  // taken per time slot, so it is approximate.
+  void setNormalizePlayer(bool enable) { normalizePlayer = enable; }
+  bool getNormalizePlayer() const { return normalizePlayer; }
+
+  // Open list implementation (default: bucket queue)
+  void setOpenListType(OpenListType type);
+  OpenListType getOpenListType() const { return openListType; }
 };
 
 #endif // SOLVER_ASTAR_H
\ No newline at end of file
@@ -11,9 +11,18 @@ struct SolverStats
   int solutionLength;
   int solutionCost;
 
+  // Learned deadlock patterns
+  int patternsLearned;       // Patterns stored (over every solve on this board)
+  long long patternLookups;  // Pattern checks made
+  long long patternHits;     // Of those, states pruned
+
   SolverStats()
       : nodesExpanded(0), nodesGenerated(0), peakOpenSize(0), peakClosedSize(0),
-        elapsedMs(0), solutionLength(0), solutionCost(0) {}
+        elapsedMs(0), solutionLength(0), solutionCost(0),
+        patternsLearned(0), patternLookups(0), patternHits(0) {}
+
+  // Share of pattern checks that pruned a state
+  double patternPruneRatio() const { return patternLookups > 0 ? double(patternHits) / patternLookups : 0.0; }
 
   void reset()
   {
@@ -24,5 +33,8 @@ struct SolverStats
     elapsedMs = 0;
     solutionLength = 0;
     solutionCost = 0;
+    patternsLearned = 0;
+    patternLookups = 0;
+    patternHits = 0;
   }
 };
\ No newline at end of file
@@ -4,21 +4,22 @@
 
 // Default constructor
 State::State()
-    : player_pos(0), key_held(-1), energy_used(0), step_mod_L(0),
+    : player_pos(0), canonical_player_pos(-1), key_held(-1), energy_used(0), step_mod_L(0),
       parent(nullptr), action_from_parent(0), zobrist_hash(0)
 {
 }
 
 // Parameterized constructor
 State::State(int playerPos, int keyHeld, int energyUsed, int stepModL)
-    : player_pos(playerPos), key_held(keyHeld), energy_used(energyUsed),
+    : player_pos(playerPos), canonical_player_pos(-1), key_held(keyHeld), energy_used(energyUsed),
       step_mod_L(stepModL), parent(nullptr), action_from_parent(0), zobrist_hash(0)
 {
 }
 
 // Copy constructor
 State::State(const State &other)
-    : player_pos(other.player_pos), boxes(other.boxes), key_held(other.key_held),
+    : player_pos(other.player_pos), canonical_player_pos(other.canonical_player_pos),
+      boxes(other.boxes), box_cells(other.box_cells), key_held(other.key_held),
       keys_on_board(other.keys_on_board), key_ids(other.key_ids),
       energy_used(other.energy_used), step_mod_L(other.step_mod_L),
       parent(other.parent), action_from_parent(other.action_from_parent),
@@ -32,7 +33,9 @@ State &State::operator=(const State &other)
   if (this != &other)
   {
     player_pos = other.player_pos;
+    canonical_player_pos = other.canonical_player_pos;
     boxes = other.boxes;
+    box_cells = other.box_cells;
     key_held = other.key_held;
     keys_on_board = other.keys_on_board;
     key_ids = other.key_ids;
@@ -76,7 +79,7 @@ void State::canonicalize()
 bool State::equals(const State &other) const
 {
   // Check basic fields
-  if (player_pos != other.player_pos ||
+  if (getCanonicalPlayerPos() != other.getCanonicalPlayerPos() ||
       key_held != other.key_held ||
       step_mod_L != other.step_mod_L ||
       boxes.getSize() != other.boxes.getSize() ||
@@ -119,10 +122,11 @@ void State::recompute_hash(const Zobrist &Z)
 
   zobrist_hash = 0;
 
-  // Hash player position
-  if (player_pos >= 0 && player_pos < Z.getBoardSize())
+  // Hash player position (the normalized cell when one is set)
+  int player = getCanonicalPlayerPos();
+  if (player >= 0 && player < Z.getBoardSize())
   {
-    zobrist_hash ^= Z.player_hash(player_pos);
+    zobrist_hash ^= Z.player_hash(player);
   }
 
   // Hash boxes
@@ -173,12 +177,15 @@ void State::addBox(int pos, char id)
 {
   BoxInfo box(pos, id);
   boxes.push_back(box);
+  box_cells.set(pos);
 }
 
 void State::removeBox(int index)
 {
   if (index >= 0 && index < boxes.getSize())
   {
+    box_cells.reset(boxes[index].pos);
+
     // Shift all boxes after index one position left
     for (int i = index; i < boxes.getSize() - 1; i++)
     {
@@ -188,8 +195,20 @@ void State::removeBox(int index)
   }
 }
 
+void State::moveBox(int index, int newPos)
+{
+  box_cells.reset(boxes[index].pos);
+  boxes[index].pos = newPos;
+  box_cells.set(newPos);
+}
+
 int State::findBoxAt(int pos) const
 {
+  if (!box_cells.test(pos))
+  {
+    return -1; // No box here
+  }
+
   for (int i = 0; i < boxes.getSize(); i++)
   {
     if (boxes[i].pos == pos)
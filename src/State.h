@@ -1,5 +1,6 @@
 #pragma once
 #include "Array.h"
+#include "CellBitset.h"
 #include <cstdint>
 
 // Forward declaration
@@ -33,7 +34,9 @@ class State
 {
 private:
   int player_pos;          // Player position on board
+  int canonical_player_pos; // Representative cell of the player's reachable area, -1 = player_pos
   Array<BoxInfo> boxes;    // Array of box positions and IDs
+  CellBitset box_cells;    // Occupancy bitset of box positions (mirrors boxes)
   int key_held;            // -1 for none, or key index/ASCII value
   Array<int> keys_on_board;   // Positions of keys still on the board
   Array<char> key_ids;        // IDs of keys on board (a-z)
@@ -63,7 +66,17 @@ public:
 
   // Accessors
   int getPlayerPos() const { return player_pos; }
-  void setPlayerPos(int pos) { player_pos = pos; }
+  void setPlayerPos(int pos)
+  {
+    player_pos = pos;
+    canonical_player_pos = -1;
+  }
+
+  // Optional normalized player cell. When set, hashing and equality use it
+  // instead of player_pos, so states whose player stands anywhere in the
+  // same reachable area coincide; moves and costs still use player_pos.
+  int getCanonicalPlayerPos() const { return canonical_player_pos < 0 ? player_pos : canonical_player_pos; }
+  void setCanonicalPlayerPos(int pos) { canonical_player_pos = pos; }
 
   int getKeyHeld() const { return key_held; }
   void setKeyHeld(int key) { key_held = key; }
@@ -80,13 +93,19 @@ public:
   char getActionFromParent() const { return action_from_parent; }
   void setActionFromParent(char action) { action_from_parent = action; }
 
-  // Box management
+  // Box management (box positions change only through addBox/removeBox/moveBox,
+  // which keep the occupancy bitset in sync)
   void addBox(int pos, char id);
   void removeBox(int index);
+  void moveBox(int index, int newPos);
   int getBoxCount() const { return boxes.getSize(); }
   const BoxInfo &getBox(int index) const { return boxes[index]; }
   BoxInfo &getBox(int index) { return boxes[index]; }
 
+  // Box occupancy - O(1)
+  bool hasBoxAt(int pos) const { return box_cells.test(pos); }
+  const CellBitset &getBoxCells() const { return box_cells; }
+
   // Find box at position
   int findBoxAt(int pos) const;
 
@@ -1,29 +1,137 @@
 #include "SuccessorGenerator.h"
 #include <iostream>
+#include <cassert>
 
 // Direction vectors for movement: up, down, left, right
 static const int dr[] = {-1, 1, 0, 0};
 static const int dc[] = {0, 0, -1, 1};
 static const char moves[] = {'U', 'D', 'L', 'R'};
 
-Array<State> generateSuccessors(const State &s, const Board &board, const Array<Door> &doors, const Meta &meta)
+// Zobrist contribution of one box (matches State::recompute_hash)
+static uint64_t boxHash(const Zobrist &Z, char id, int pos)
 {
-  Array<State> successors;
+  return id == 0 ? Z.box_hash_unlabeled(pos) : Z.box_hash_letter(id, pos);
+}
 
-  // Initialize player pathfinder
-  PlayerPathfinder pathfinder;
-  pathfinder.initialize(board, doors);
+// Cells involved in pushing the box at box_pos in direction dir: where the
+// player stands and where the box lands. False if either is off the board.
+static bool pushCells(int box_pos, int dir, int rows, int cols, int &player_target, int &box_dest)
+{
+  int box_row = box_pos / cols;
+  int box_col = box_pos % cols;
+  int player_target_row = box_row - dr[dir]; // Where player needs to be to push
+  int player_target_col = box_col - dc[dir];
+  int box_dest_row = box_row + dr[dir]; // Where box will end up
+  int box_dest_col = box_col + dc[dir];
+
+  // Check bounds for player target position
+  if (player_target_row < 0 || player_target_row >= rows ||
+      player_target_col < 0 || player_target_col >= cols)
+  {
+    return false;
+  }
+
+  // Check bounds for box destination
+  if (box_dest_row < 0 || box_dest_row >= rows ||
+      box_dest_col < 0 || box_dest_col >= cols)
+  {
+    return false;
+  }
+
+  player_target = player_target_row * cols + player_target_col;
+  box_dest = box_dest_row * cols + box_dest_col;
+  return true;
+}
+
+// Door-free boards: flood-fill the reachable region bit-parallel, then run
+// the BFS only until every cell a successor can start from has a distance.
+// Mirrors the static checks of the generation loop; anything filtered here
+// is rejected there as well, so missing distances are never consulted.
+static void findNeededPaths(const State &s, const Board &board, PlayerPathfinder &pathfinder,
+                            const CellBitset *deadSquares)
+{
+  int rows = board.get_height();
+  int cols = board.get_width();
+
+  pathfinder.floodFill(s.getPlayerPos());
+
+  CellBitset needed;
+  int neededCount = 0;
+  for (int box_idx = 0; box_idx < s.getBoxCount(); box_idx++)
+  {
+    const BoxInfo &box = s.getBox(box_idx);
+    if (box.id != 0 && s.getKeyHeld() != box.id - 'A')
+      continue;
+
+    for (int dir = 0; dir < 4; dir++)
+    {
+      int player_target, box_dest;
+      if (!pushCells(box.pos, dir, rows, cols, player_target, box_dest))
+        continue;
+      if (needed.test(player_target) || !pathfinder.isReachable(player_target))
+        continue;
+      if (board.is_wall_idx(box_dest) || s.hasBoxAt(box_dest) || !board.is_open_idx(box_dest, 0))
+        continue;
+      if (deadSquares && deadSquares->test(box_dest))
+        continue;
 
-  // Block box positions so pathfinder knows player can't walk through them
-  Array<int> boxPositions;
-  for (int i = 0; i < s.getBoxCount(); i++)
+      needed.set(player_target);
+      neededCount++;
+    }
+  }
+
+  if (s.getKeyHeld() == -1)
   {
-    boxPositions.push_back(s.getBox(i).pos);
+    for (int key_idx = 0; key_idx < s.getKeyCount(); key_idx++)
+    {
+      int key_pos = s.getKeyPos(key_idx);
+      if (!needed.test(key_pos) && pathfinder.isReachable(key_pos))
+      {
+        needed.set(key_pos);
+        neededCount++;
+      }
+    }
   }
-  pathfinder.setBlockedPositions(boxPositions);
+
+  pathfinder.findPathsTo(s.getPlayerPos(), s.getStepModL(), needed, neededCount);
+}
+
+#ifdef DEBUG
+// Cross-check an incrementally updated hash against a full recomputation
+static void verifyHash(const State &state, const Zobrist &Z)
+{
+  State check = state;
+  check.recompute_hash(Z);
+  assert(check.hash() == state.hash());
+}
+#endif
+
+Array<State> generateSuccessors(const State &s, const Board &board, const Array<Door> &doors, const Meta &meta,
+                                const Zobrist *zobrist)
+{
+  PlayerPathfinder pathfinder;
+  pathfinder.initialize(board, doors);
+  return generateSuccessors(s, board, doors, meta, pathfinder, zobrist, nullptr);
+}
+
+Array<State> generateSuccessors(const State &s, const Board &board, const Array<Door> & /*doors*/, const Meta &meta,
+                                PlayerPathfinder &pathfinder, const Zobrist *zobrist,
+                                const CellBitset *deadSquares)
+{
+  Array<State> successors;
+
+  // Block box cells so pathfinder knows player can't walk through them
+  pathfinder.setBlockedCells(s.getBoxCells());
 
   // Run BFS from current player position and time
-  pathfinder.findPaths(s.getPlayerPos(), s.getStepModL());
+  if (pathfinder.hasBitParallelFill())
+  {
+    findNeededPaths(s, board, pathfinder, deadSquares);
+  }
+  else
+  {
+    pathfinder.findPaths(s.getPlayerPos(), s.getStepModL());
+  }
 
   int L = board.getTimeModuloL();
   int rows = board.get_height();
@@ -36,36 +144,16 @@ Array<State> generateSuccessors(const State &s, const Board &board, const Array<
     int box_pos = box.pos;
     char box_id = box.id;
 
-    // Get box coordinates
-    int box_row = box_pos / cols;
-    int box_col = box_pos % cols;
-
     // Try each direction
     for (int dir = 0; dir < 4; dir++)
     {
       // Calculate positions
-      int player_target_row = box_row - dr[dir]; // Where player needs to be to push
-      int player_target_col = box_col - dc[dir];
-      int box_dest_row = box_row + dr[dir]; // Where box will end up
-      int box_dest_col = box_col + dc[dir];
-
-      // Check bounds for player target position
-      if (player_target_row < 0 || player_target_row >= rows ||
-          player_target_col < 0 || player_target_col >= cols)
+      int player_target, box_dest;
+      if (!pushCells(box_pos, dir, rows, cols, player_target, box_dest))
       {
         continue;
       }
 
-      // Check bounds for box destination
-      if (box_dest_row < 0 || box_dest_row >= rows ||
-          box_dest_col < 0 || box_dest_col >= cols)
-      {
-        continue;
-      }
-
-      int player_target = player_target_row * cols + player_target_col;
-      int box_dest = box_dest_row * cols + box_dest_col;
-
       // Check if player can reach the target position
       int move_distance = pathfinder.getDistance(player_target);
       if (move_distance == -1)
@@ -79,17 +167,14 @@ Array<State> generateSuccessors(const State &s, const Board &board, const Array<
         continue; // Cannot push box into wall
       }
 
-      // Check if another box is already at destination
-      bool box_collision = false;
-      for (int other_box = 0; other_box < s.getBoxCount(); other_box++)
+      // No goal can be reached from a dead square
+      if (deadSquares && deadSquares->test(box_dest))
       {
-        if (other_box != box_idx && s.getBox(other_box).pos == box_dest)
-        {
-          box_collision = true;
-          break;
-        }
+        continue;
       }
-      if (box_collision)
+
+      // Check if another box is already at destination
+      if (s.hasBoxAt(box_dest))
       {
         continue; // Cannot push box into another box
       }
@@ -99,22 +184,9 @@ Array<State> generateSuccessors(const State &s, const Board &board, const Array<
       int push_time = (s.getStepModL() + total_steps) % L;
 
       // Check if box destination has a door that must be open at push time
-      int door_id = board.get_door_id_idx(box_dest);
-      if (door_id > 0)
-      { // There is a door at destination
-        bool door_open = false;
-        for (int door_idx = 0; door_idx < doors.getSize(); door_idx++)
-        {
-          if (doors[door_idx].id == door_id)
-          {
-            door_open = doors[door_idx].isOpenAtTime(push_time);
-            break;
-          }
-        }
-        if (!door_open)
-        {
-          continue; // Door is closed at the time of push
-        }
+      if (!board.is_open_idx(box_dest, push_time))
+      {
+        continue; // Door is closed at the time of push
       }
 
       // Check if box is locked and player has the right key
@@ -141,8 +213,8 @@ Array<State> generateSuccessors(const State &s, const Board &board, const Array<
       // Update player position to box's current position
       new_state.setPlayerPos(box_pos);
 
-      // Update box position
-      new_state.getBox(box_idx).pos = box_dest;
+      // Update box position (keeps the occupancy bitset in sync)
+      new_state.moveBox(box_idx, box_dest);
 
       // Update timing
       int new_step_mod_L = (s.getStepModL() + total_steps) % L;
@@ -164,9 +236,30 @@ Array<State> generateSuccessors(const State &s, const Board &board, const Array<
       new_state.setParent(const_cast<State *>(&s));
       new_state.setActionFromParent(moves[dir]);
 
+      // Hash delta: player, moved box (and its unlock), held key, time slot
+      if (zobrist != nullptr)
+      {
+        uint64_t h = s.hash();
+        h ^= zobrist->player_hash(s.getCanonicalPlayerPos()) ^ zobrist->player_hash(box_pos);
+        h ^= boxHash(*zobrist, box_id, box_pos) ^ boxHash(*zobrist, 0, box_dest);
+        if (box_id != 0)
+        {
+          h ^= zobrist->key_hash(s.getKeyHeld() + 1) ^ zobrist->key_hash(0);
+        }
+        h ^= zobrist->time_hash(s.getStepModL()) ^ zobrist->time_hash(new_step_mod_L);
+        new_state.setZobristHash(h);
+      }
+
       // Canonicalize the state (sort unlabeled boxes)
       new_state.canonicalize();
 
+#ifdef DEBUG
+      if (zobrist != nullptr)
+      {
+        verifyHash(new_state, *zobrist);
+      }
+#endif
+
       // Add to successors
       successors.push_back(new_state);
     }
@@ -219,9 +312,27 @@ Array<State> generateSuccessors(const State &s, const Board &board, const Array<
       new_state.setParent(const_cast<State *>(&s));
       new_state.setActionFromParent('K');
 
+      // Hash delta: player, held key, key leaving the board, time slot
+      if (zobrist != nullptr)
+      {
+        uint64_t h = s.hash();
+        h ^= zobrist->player_hash(s.getCanonicalPlayerPos()) ^ zobrist->player_hash(key_pos);
+        h ^= zobrist->key_hash(0) ^ zobrist->key_hash(key_index + 1);
+        h ^= zobrist->key_on_board_hash(key_id, key_pos);
+        h ^= zobrist->time_hash(s.getStepModL()) ^ zobrist->time_hash(new_step_mod_L);
+        new_state.setZobristHash(h);
+      }
+
       // Canonicalize the state (sort unlabeled boxes)
       new_state.canonicalize();
 
+#ifdef DEBUG
+      if (zobrist != nullptr)
+      {
+        verifyHash(new_state, *zobrist);
+      }
+#endif
+
       // Add to successors
       successors.push_back(new_state);
     }
@@ -6,7 +6,21 @@
 #include "Array.h"
 #include "PlayerPathfinder.h"
 #include "Meta.h"
+#include "Zobrist.h"
 
 // Phase 5: Push-based neighbor generation
-// Generates successor states by considering all possible box pushes
-Array<State> generateSuccessors(const State &s, const Board &board, const Array<Door> &doors, const Meta &meta);
\ No newline at end of file
+// Generates successor states by considering all possible box pushes.
+// When zobrist is given, each successor's hash is derived from the parent's
+// cached hash by XOR-ing only the components that changed (s.hash() must be
+// valid); otherwise successors keep the parent's stale hash.
+Array<State> generateSuccessors(const State &s, const Board &board, const Array<Door> &doors, const Meta &meta,
+                                const Zobrist *zobrist = nullptr);
+
+// Same, but runs the player reachability BFS in the caller's pathfinder
+// (already initialized for this board and doors). On return it holds the
+// BFS from s, so the caller can extract the walk to each successor with
+// getPath without searching again.
+// When deadSquares is given, pushes onto those cells are skipped.
+Array<State> generateSuccessors(const State &s, const Board &board, const Array<Door> &doors, const Meta &meta,
+                                PlayerPathfinder &pathfinder, const Zobrist *zobrist = nullptr,
+                                const CellBitset *deadSquares = nullptr);
\ No newline at end of file
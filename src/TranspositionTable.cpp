@@ -0,0 +1,118 @@
+#include "TranspositionTable.h"
+#include <cstring>
+
+// Constructor
+TranspositionTable::TranspositionTable(const PackedStatePool &pool)
+    : states(pool), slots(nullptr), capacity(INITIAL_CAPACITY), size(0)
+{
+  slots = new Slot[capacity];
+  clear();
+}
+
+// Destructor
+TranspositionTable::~TranspositionTable()
+{
+  delete[] slots;
+}
+
+// Linear probe: stop at the matching state or the first empty slot
+int TranspositionTable::probe(uint64_t hash, const uint8_t *packed) const
+{
+  int keySize = states.getKeySize();
+  int mask = capacity - 1;
+  int i = static_cast<int>(hash & mask);
+
+  while (slots[i].nodeId != EMPTY)
+  {
+    if (slots[i].hash == hash && memcmp(states.get(slots[i].nodeId), packed, keySize) == 0)
+    {
+      return i;
+    }
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+// Look up a packed state - one probe sequence, verified on the stored bytes
+bool TranspositionTable::find(uint64_t hash, const uint8_t *packed, uint32_t &outNodeId, int &outG) const
+{
+  const Slot &slot = slots[probe(hash, packed)];
+  if (slot.nodeId == EMPTY)
+  {
+    return false;
+  }
+  outNodeId = slot.nodeId;
+  outG = slot.g;
+  return true;
+}
+
+// Insert or improve the entry for the state of `nodeId`
+bool TranspositionTable::update(uint32_t nodeId, uint64_t hash, int g)
+{
+  Slot &slot = slots[probe(hash, states.get(nodeId))];
+
+  if (slot.nodeId != EMPTY)
+  {
+    if (slot.g <= g)
+    {
+      return false; // Already reached at least as cheaply
+    }
+    slot.nodeId = nodeId;
+    slot.g = g;
+    return true;
+  }
+
+  slot.hash = hash;
+  slot.nodeId = nodeId;
+  slot.g = g;
+  size++;
+
+  // Keep the load factor at or below 3/4
+  if (size * 4 > capacity * 3)
+  {
+    grow();
+  }
+  return true;
+}
+
+// Double the slot array and reinsert every entry (hashes are stored, so no
+// state comparisons are needed while rehashing)
+void TranspositionTable::grow()
+{
+  Slot *oldSlots = slots;
+  int oldCapacity = capacity;
+
+  capacity *= 2;
+  slots = new Slot[capacity];
+  for (int i = 0; i < capacity; i++)
+  {
+    slots[i].nodeId = EMPTY;
+  }
+
+  int mask = capacity - 1;
+  for (int i = 0; i < oldCapacity; i++)
+  {
+    if (oldSlots[i].nodeId == EMPTY)
+    {
+      continue;
+    }
+    int j = static_cast<int>(oldSlots[i].hash & mask);
+    while (slots[j].nodeId != EMPTY)
+    {
+      j = (j + 1) & mask;
+    }
+    slots[j] = oldSlots[i];
+  }
+
+  delete[] oldSlots;
+}
+
+// Remove every entry
+void TranspositionTable::clear()
+{
+  for (int i = 0; i < capacity; i++)
+  {
+    slots[i].nodeId = EMPTY;
+  }
+  size = 0;
+}
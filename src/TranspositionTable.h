@@ -0,0 +1,60 @@
+#pragma once
+#include "PackedState.h"
+#include <cstdint>
+
+// Open-addressing transposition table for the search.
+// Each slot holds the state's Zobrist hash, the id of the best node seen for
+// that state and its g cost. Packed states live in the pool under the node's
+// id, so a hash match is confirmed by comparing the packed key bytes before it
+// counts as a hit; a hash collision can never prune a different state. Linear
+// probing over a power-of-two slot array, grown when the load factor passes 3/4.
+class TranspositionTable
+{
+private:
+  struct Slot
+  {
+    uint64_t hash;   // Zobrist hash of the stored state
+    uint32_t nodeId; // Best node for this state (EMPTY = unused slot)
+    int g;           // Best g cost seen for this state
+  };
+
+  static const int INITIAL_CAPACITY = 1 << 12;
+  static const uint32_t EMPTY = 0xFFFFFFFFu; // nodeId of an unused slot
+
+  const PackedStatePool &states; // Packed states referenced by slot node ids
+  Slot *slots;
+  int capacity; // Always a power of two
+  int size;     // Occupied slots
+
+  void grow();
+
+  // Probe for a packed state; returns its slot, or the empty slot where it belongs
+  int probe(uint64_t hash, const uint8_t *packed) const;
+
+public:
+  // Constructor - the table verifies hits against records in `pool`
+  explicit TranspositionTable(const PackedStatePool &pool);
+
+  // Destructor
+  ~TranspositionTable();
+
+  // The table owns its slot array, so copying is not allowed
+  TranspositionTable(const TranspositionTable &) = delete;
+  TranspositionTable &operator=(const TranspositionTable &) = delete;
+
+  // Look up a packed state; returns false if unseen, else fills the stored node id and g
+  bool find(uint64_t hash, const uint8_t *packed, uint32_t &outNodeId, int &outG) const;
+
+  // Record `nodeId` (whose packed state is already in the pool) with cost g.
+  // Returns false without changing anything if the state is already stored
+  // with g <= the given cost; otherwise inserts or replaces the entry.
+  bool update(uint32_t nodeId, uint64_t hash, int g);
+
+  // Remove every entry (keeps the slot array)
+  void clear();
+
+  // Utility methods
+  int getSize() const { return size; }
+  int getCapacity() const { return capacity; }
+  bool isEmpty() const { return size == 0; }
+};
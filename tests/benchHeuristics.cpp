@@ -0,0 +1,139 @@
+#include "../src/SokobanHeuristics.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+// SokobanHeuristics::heuristic microbenchmark.
+// An open 16x16 room with n goals; a fixed pool of random n-box states is
+// evaluated repeatedly. Reports heuristic calls per second for 4..12 boxes
+// and heap allocations per call (counted by replacing global operator new).
+// The h sum over the pool makes the work observable and lets runs compare
+// the bound they compute.
+//
+// Usage: ./bin/benchHeuristics
+
+static const int side = 16;
+static const int poolSize = 256;
+static const int calls = 200000;
+
+// Every heap allocation in the process goes through these
+static long long allocationCount = 0;
+
+void *operator new(std::size_t size)
+{
+  allocationCount++;
+  void *p = std::malloc(size ? size : 1);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+void *operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+// Pick a random interior cell not in used, then mark it
+static int randomCell(Array<bool> &used)
+{
+  while (true)
+  {
+    int row = 1 + rand() % (side - 2);
+    int col = 1 + rand() % (side - 2);
+    int pos = row * side + col;
+    if (!used[pos])
+    {
+      used[pos] = true;
+      return pos;
+    }
+  }
+}
+
+static void benchBoxes(int n)
+{
+  srand(1000 + n);
+
+  Board board;
+  board.initialize(side, side);
+  for (int i = 0; i < side; i++)
+  {
+    board.set_wall(0, i);
+    board.set_wall(side - 1, i);
+    board.set_wall(i, 0);
+    board.set_wall(i, side - 1);
+  }
+
+  Array<bool> goalUsed;
+  for (int i = 0; i < side * side; i++)
+  {
+    goalUsed.push_back(false);
+  }
+  for (int g = 0; g < n; g++)
+  {
+    int pos = randomCell(goalUsed);
+    board.set_target(pos / side, pos % side);
+  }
+
+  SokobanHeuristics heuristics;
+  heuristics.initialize(board);
+
+  Array<State> pool;
+  for (int i = 0; i < poolSize; i++)
+  {
+    Array<bool> used;
+    for (int c = 0; c < side * side; c++)
+    {
+      used.push_back(false);
+    }
+    State s(randomCell(used), -1, 0, 0);
+    for (int b = 0; b < n; b++)
+    {
+      s.addBox(randomCell(used), 0);
+    }
+    s.canonicalize();
+    pool.push_back(s);
+  }
+
+  long long hSum = 0;
+  for (int i = 0; i < poolSize; i++)
+  {
+    hSum += heuristics.heuristic(pool[i]);
+  }
+
+  long long checksum = 0;
+  long long allocationsBefore = allocationCount;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < calls; i++)
+  {
+    checksum += heuristics.heuristic(pool[i % poolSize]);
+  }
+  auto end = std::chrono::steady_clock::now();
+  long long allocations = allocationCount - allocationsBefore;
+  double us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+  std::cout << std::setw(6) << n << std::setw(10) << calls
+            << std::setw(14) << std::fixed << std::setprecision(0) << calls * 1e6 / us
+            << std::setw(10) << std::setprecision(2) << us / calls
+            << std::setw(12) << std::setprecision(3) << double(allocations) / calls
+            << std::setw(10) << hSum << std::setw(14) << checksum << "\n";
+}
+
+int main()
+{
+  std::cout << "\n=== Heuristic Benchmark ===\n";
+  std::cout << std::setw(6) << "boxes" << std::setw(10) << "calls" << std::setw(14) << "calls/s"
+            << std::setw(10) << "us/call" << std::setw(12) << "allocs/call" << std::setw(10) << "h sum" << std::setw(14) << "checksum" << "\n";
+
+  for (int n = 4; n <= 12; n++)
+  {
+    benchBoxes(n);
+  }
+  return 0;
+}
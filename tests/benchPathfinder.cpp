@@ -0,0 +1,101 @@
+#include "../src/PlayerPathfinder.h"
+#include "../src/ConfigParser.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+// PlayerPathfinder::findPaths microbenchmark.
+// For each level, one pathfinder is initialized once and findPaths is run
+// repeatedly from the level's start position with the initial boxes blocked,
+// as the solver does once per expansion. Reports microseconds per call.
+// Door-free boards also report the bit-parallel floodFill ("fill us").
+//
+// Usage: ./bin/benchPathfinder [config files...]   (defaults to Easy-4 and the Hard configs)
+
+static const char *defaultConfigs[] = {
+    "configs/Easy-4.txt", "configs/Hard-1.txt", "configs/Hard-2.txt", "configs/Hard-3.txt", "configs/Hard-4.txt"};
+
+static const int iterations = 20000;
+
+static bool benchLevel(const char *filename)
+{
+  Meta meta;
+  Board board;
+  Array<Door> doors;
+  InitialDynamicState init;
+  ConfigParser parser;
+
+  if (!parser.parse(filename, meta, board, doors, init))
+  {
+    std::cerr << "Failed to load " << filename << std::endl;
+    return false;
+  }
+
+  Array<int> boxes;
+  for (int i = 0; i < init.unlockedBoxes.getSize(); i++)
+  {
+    boxes.push_back(init.unlockedBoxes[i]);
+  }
+  for (int i = 0; i < init.lockedBoxes.getSize(); i++)
+  {
+    boxes.push_back(init.lockedBoxes[i]);
+  }
+
+  PlayerPathfinder pathfinder;
+  pathfinder.initialize(board, doors);
+  pathfinder.setBlockedPositions(boxes);
+
+  // Checksum keeps the work observable
+  long long checksum = 0;
+  int cells = board.get_width() * board.get_height();
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+  {
+    pathfinder.findPaths(init.player_pos, i % board.getTimeModuloL());
+    checksum += pathfinder.getDistance(i % cells);
+  }
+  auto end = std::chrono::steady_clock::now();
+  double us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+  double fillUs = -1;
+  if (pathfinder.hasBitParallelFill())
+  {
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      pathfinder.floodFill(init.player_pos);
+      checksum += pathfinder.isReachable(i % cells);
+    }
+    end = std::chrono::steady_clock::now();
+    fillUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  }
+
+  std::cout << std::left << std::setw(24) << filename << std::right
+            << std::setw(6) << cells << std::setw(6) << board.getTimeModuloL()
+            << std::setw(10) << iterations << std::setw(14) << std::fixed << std::setprecision(2)
+            << us / iterations;
+  if (fillUs >= 0)
+    std::cout << std::setw(10) << fillUs / iterations;
+  else
+    std::cout << std::setw(10) << "-";
+  std::cout << std::setw(14) << checksum << "\n";
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  int numConfigs = sizeof(defaultConfigs) / sizeof(defaultConfigs[0]);
+  int numLevels = argc > 1 ? argc - 1 : numConfigs;
+
+  std::cout << "\n=== findPaths Benchmark ===\n";
+  std::cout << std::left << std::setw(24) << "level" << std::right
+            << std::setw(6) << "cells" << std::setw(6) << "L"
+            << std::setw(10) << "calls" << std::setw(14) << "us/call" << std::setw(10) << "fill us" << std::setw(14) << "checksum" << "\n";
+
+  for (int i = 0; i < numLevels; i++)
+  {
+    benchLevel(argc > 1 ? argv[i + 1] : defaultConfigs[i]);
+  }
+  return 0;
+}
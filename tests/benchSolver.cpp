@@ -0,0 +1,144 @@
+#include "../src/SolverAStar.h"
+#include "../src/Simulation.h"
+#include "../src/ConfigParser.h"
+#include "../src/Zobrist.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+// Solver throughput benchmark.
+// Runs each level with growing expansion limits and reports expansions/sec
+// for every run. With O(1) node lookup the rate should stay roughly flat as
+// the number of stored nodes grows. Every level is run once per solver
+// configuration: binary heap, bucket queue, and bucket queue with player
+// normalization ("norm").
+//
+// Usage: ./bin/benchSolver [config files...]   (defaults to configs/*.txt)
+
+static const char *defaultConfigs[] = {
+    "configs/Easy-1.txt", "configs/Easy-2.txt", "configs/Easy-3.txt",
+    "configs/Easy-4.txt", "configs/Easy-5.txt", "configs/Easy-6.txt",
+    "configs/Medium-1.txt", "configs/Medium-2.txt", "configs/Medium-3.txt",
+    "configs/Medium-4.txt", "configs/Hard-1.txt", "configs/Hard-2.txt",
+    "configs/Hard-3.txt", "configs/Hard-4.txt"};
+
+static const int expansionLimits[] = {1000, 4000, 16000, 64000};
+
+struct SolverConfig
+{
+  OpenListType openList;
+  bool normalizePlayer;
+  const char *name;
+};
+
+static const SolverConfig solverConfigs[] = {
+    {OPEN_LIST_BINARY_HEAP, false, "heap"},
+    {OPEN_LIST_BUCKET, false, "bucket"},
+    {OPEN_LIST_BUCKET, true, "norm"}};
+
+struct BenchRow
+{
+  std::string level;
+  const char *config;
+  int limit;
+  bool solved;
+  bool valid;
+  int expanded;
+  int generated;
+  int cost;
+  long long ms;
+};
+
+static bool benchLevel(const char *filename, int configIndex, BenchRow *rows, int &rowCount)
+{
+  Meta meta;
+  Board board;
+  Array<Door> doors;
+  InitialDynamicState init;
+  ConfigParser parser;
+
+  if (!parser.parse(filename, meta, board, doors, init))
+  {
+    std::cerr << "Failed to load " << filename << std::endl;
+    return false;
+  }
+
+  Zobrist zobrist;
+  zobrist.init(board.get_width() * board.get_height(), 26, 26, board.getTimeModuloL(), 12345);
+
+  int numLimits = sizeof(expansionLimits) / sizeof(expansionLimits[0]);
+  for (int i = 0; i < numLimits; i++)
+  {
+    SolverAStar solver(board, doors, meta, zobrist);
+    solver.setExpansionLimit(expansionLimits[i]);
+    solver.setOpenListType(solverConfigs[configIndex].openList);
+    solver.setNormalizePlayer(solverConfigs[configIndex].normalizePlayer);
+
+    Array<char> moves;
+    SolverStats stats;
+    bool solved = solver.solve(init, moves, stats);
+
+    // Replay the solution to make sure it actually solves the level
+    bool valid = false;
+    if (solved)
+    {
+      DynamicState ds(init);
+      valid = Simulation::simulateMoves(board, ds, moves, doors, meta) && ds.isWin(board);
+    }
+
+    BenchRow &row = rows[rowCount++];
+    row.level = filename;
+    row.config = solverConfigs[configIndex].name;
+    row.limit = expansionLimits[i];
+    row.solved = solved;
+    row.valid = valid;
+    row.expanded = stats.nodesExpanded;
+    row.generated = stats.nodesGenerated;
+    row.cost = solved ? stats.solutionCost : -1;
+    row.ms = stats.elapsedMs;
+
+    // Once solved, larger limits would repeat the same search
+    if (solved)
+      break;
+  }
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  int numLimits = sizeof(expansionLimits) / sizeof(expansionLimits[0]);
+  int numConfigs = sizeof(defaultConfigs) / sizeof(defaultConfigs[0]);
+  int numSolverConfigs = sizeof(solverConfigs) / sizeof(solverConfigs[0]);
+  int numLevels = argc > 1 ? argc - 1 : numConfigs;
+
+  BenchRow *rows = new BenchRow[numLevels * numSolverConfigs * numLimits];
+  int rowCount = 0;
+
+  for (int i = 0; i < numLevels; i++)
+  {
+    for (int j = 0; j < numSolverConfigs; j++)
+    {
+      benchLevel(argc > 1 ? argv[i + 1] : defaultConfigs[i], j, rows, rowCount);
+    }
+  }
+
+  std::cout << "\n=== Solver Benchmark ===\n";
+  std::cout << std::left << std::setw(24) << "level" << std::right
+            << std::setw(8) << "config" << std::setw(8) << "limit" << std::setw(8) << "solved"
+            << std::setw(10) << "expanded" << std::setw(11) << "generated" << std::setw(7) << "cost"
+            << std::setw(9) << "ms" << std::setw(14) << "expansions/s" << "\n";
+
+  for (int i = 0; i < rowCount; i++)
+  {
+    const BenchRow &row = rows[i];
+    double rate = row.ms > 0 ? (row.expanded * 1000.0 / row.ms) : 0.0;
+    std::cout << std::left << std::setw(24) << row.level << std::right
+              << std::setw(8) << row.config << std::setw(8) << row.limit
+              << std::setw(8) << (row.solved ? (row.valid ? "yes" : "BAD") : "no")
+              << std::setw(10) << row.expanded << std::setw(11) << row.generated << std::setw(7) << row.cost
+              << std::setw(9) << row.ms << std::setw(14) << std::fixed << std::setprecision(0) << rate << "\n";
+  }
+
+  delete[] rows;
+  return 0;
+}
@@ -0,0 +1,32 @@
+#include "../src/PatternTable.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+// Generates the deadlock table loaded by SokobanHeuristics.
+// Usage: genPatternTable [output path] [max boxes per proof]
+int main(int argc, char **argv)
+{
+  std::string path = argc > 1 ? argv[1] : PatternTable::DEFAULT_PATH;
+  int maxBoxes = argc > 2 ? std::atoi(argv[2]) : PatternTable::DEFAULT_MAX_BOXES;
+  if (maxBoxes < 1 || maxBoxes > PatternTable::CELLS)
+  {
+    std::cerr << "Max boxes must be between 1 and " << PatternTable::CELLS << std::endl;
+    return 1;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  PatternTable table;
+  table.generate(maxBoxes);
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+  if (!table.save(path))
+  {
+    std::cerr << "Cannot write " << path << std::endl;
+    return 1;
+  }
+  std::cout << "Wrote " << path << ": " << table.getDeadCount() << " of " << PatternTable::CODE_COUNT
+            << " " << PatternTable::WINDOW << "x" << PatternTable::WINDOW << " blocks dead (up to "
+            << maxBoxes << " boxes proven, " << ms << " ms)" << std::endl;
+  return 0;
+}
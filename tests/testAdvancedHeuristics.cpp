@@ -234,6 +234,79 @@ void test_hungarian_vs_simple_comparison()
   std::cout << "✓ Hungarian vs Simple comparison test passed!" << std::endl;
 }
 
+void test_freeze_deadlock()
+{
+  std::cout << "\n=== Testing Freeze Deadlock From The Pushed Box ===\n";
+
+  // Layout (goals at (1,1) and (3,5)):
+  // #######
+  // #.    #
+  // #     #
+  // #    .#
+  // #######
+  Board board;
+  board.initialize(7, 5);
+  for (int col = 0; col < 7; col++)
+  {
+    board.set_wall(0, col);
+    board.set_wall(4, col);
+  }
+  for (int row = 0; row < 5; row++)
+  {
+    board.set_wall(row, 0);
+    board.set_wall(row, 6);
+  }
+  board.set_target(1, 1);
+  board.set_target(3, 5);
+
+  SokobanHeuristics heuristics;
+  heuristics.initialize(board);
+
+  Zobrist zobrist;
+  zobrist.init(35, 10, 5, 1);
+
+  // Two boxes side by side against the top wall: each blocks the other
+  // horizontally, the wall blocks them vertically. Neither is a dead square
+  // on its own (the top wall leads to the goal at (1,1)).
+  State pair(1 * 7 + 4, -1, 0, 0);
+  pair.addBox(1 * 7 + 2, 0);
+  pair.addBox(1 * 7 + 3, 0);
+  pair.setActionFromParent('L'); // Player at (1,4) pushed the box onto (1,3)
+  pair.recompute_hash(zobrist);
+  assert(!heuristics.isDeadSquare(1 * 7 + 2) && !heuristics.isDeadSquare(1 * 7 + 3));
+  assert(heuristics.isFreezeDeadlocked(pair, 1 * 7 + 3));
+  assert(heuristics.isPushDeadlocked(pair));
+
+  // Stacked vertically in open space: both can still move sideways
+  State column(3 * 7 + 3, -1, 0, 0);
+  column.addBox(1 * 7 + 3, 0);
+  column.addBox(2 * 7 + 3, 0);
+  column.setActionFromParent('U');
+  column.recompute_hash(zobrist);
+  assert(!heuristics.isFreezeDeadlocked(column, 2 * 7 + 3));
+  assert(!heuristics.isPushDeadlocked(column));
+
+  // A frozen pair is fine when both boxes sit on goals
+  Board goals_board = board;
+  goals_board.set_target(1, 2);
+  SokobanHeuristics goal_heuristics;
+  goal_heuristics.initialize(goals_board);
+  State on_goals(1 * 7 + 3, -1, 0, 0);
+  on_goals.addBox(1 * 7 + 1, 0);
+  on_goals.addBox(1 * 7 + 2, 0);
+  on_goals.setActionFromParent('L');
+  on_goals.recompute_hash(zobrist);
+  assert(!goal_heuristics.isFreezeDeadlocked(on_goals, 1 * 7 + 2));
+  assert(!goal_heuristics.isPushDeadlocked(on_goals));
+
+  // Key pickups move no box and are never reported
+  State pickup = pair;
+  pickup.setActionFromParent('K');
+  assert(!heuristics.isPushDeadlocked(pickup));
+
+  std::cout << "✓ Freeze deadlock test passed!" << std::endl;
+}
+
 int main()
 {
   std::cout << "Testing Advanced Sokoban Heuristics (Phase 6)" << std::endl;
@@ -245,12 +318,14 @@ int main()
     test_wall_deadlock_detection();
     test_no_wall_deadlock_with_goal();
     test_hungarian_vs_simple_comparison();
+    test_freeze_deadlock();
 
     std::cout << "\n🎉 All Phase 6 tests passed successfully!" << std::endl;
     std::cout << "\nAdvanced heuristics implementation complete:" << std::endl;
     std::cout << "- Hungarian assignment algorithm for optimal box-goal matching" << std::endl;
     std::cout << "- Wall deadlock detection (Stage 2)" << std::endl;
     std::cout << "- Corner deadlock detection (Stage 1)" << std::endl;
+    std::cout << "- Freeze deadlock detection from the pushed box" << std::endl;
     std::cout << "- Comprehensive integration with existing solver" << std::endl;
 
     return 0;
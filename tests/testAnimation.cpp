@@ -152,33 +152,55 @@ void test_path_reconstruction()
 {
   std::cout << "\n=== Testing Path Reconstruction ===\n";
 
-  // Create mock A* nodes for testing
-  // Note: In real usage, these would be created by the solver
-
-  // Create a simple chain: root -> node1 -> node2 (goal)
-  State rootState, node1State, node2State;
-
-  AStarNode root;
-  root.state = rootState;
-  root.parent = nullptr;
-  // root has no actions (starting state)
-
-  AStarNode node1;
-  node1.state = node1State;
-  node1.parent = reinterpret_cast<State *>(&root);
-  node1.actionsFromParent.push_back('U');
-  node1.actionsFromParent.push_back('R');
-
-  AStarNode goal;
-  goal.state = node2State;
-  goal.parent = reinterpret_cast<State *>(&node1);
-  goal.actionsFromParent.push_back('D');
-  goal.actionsFromParent.push_back('L');
-  goal.actionsFromParent.push_back('D');
+  // Open 4x4 room inside walls; box at (2,2), player at (4,1)
+  Board board;
+  board.initialize(6, 6);
+  for (int i = 0; i < 6; i++)
+  {
+    board.set_wall(0, i);
+    board.set_wall(5, i);
+    board.set_wall(i, 0);
+    board.set_wall(i, 5);
+  }
+  board.set_target(1, 3);
+  Array<Door> doors;
+  int cols = 6;
+
+  // Chain of pushes: root -> push box up -> push box right (goal).
+  // Nodes only record the push; the walks are recomputed.
+  State root(4 * cols + 1, -1, 0, 0);
+  root.addBox(2 * cols + 2, 0);
+
+  State pushedUp = root;
+  pushedUp.moveBox(0, 1 * cols + 2);
+  pushedUp.setPlayerPos(2 * cols + 2);
+
+  State pushedRight = pushedUp;
+  pushedRight.moveBox(0, 1 * cols + 3);
+  pushedRight.setPlayerPos(1 * cols + 2);
+
+  StatePacker packer;
+  packer.initialize(root);
+  PackedStatePool states;
+  states.reset(packer.getRecordSize());
+  NodeArena<AStarNode> nodes;
+
+  const State *chain[] = {&root, &pushedUp, &pushedRight};
+  const char actions[] = {0, 'U', 'R'};
+  for (int i = 0; i < 3; i++)
+  {
+    uint32_t id = nodes.allocate();
+    states.allocate();
+    packer.pack(*chain[i], states.get(id));
+    AStarNode &node = nodes.get(id);
+    node.id = id;
+    node.parent = i == 0 ? NodeArena<AStarNode>::NO_NODE : id - 1;
+    node.action = actions[i];
+  }
 
   // Reconstruct path
   Array<char> reconstructedMoves;
-  Simulation::reconstruct_moves(&goal, reconstructedMoves);
+  Simulation::reconstruct_moves(board, doors, nodes, states, packer, 2, reconstructedMoves);
 
   std::cout << "Reconstructed move sequence: ";
   for (int i = 0; i < reconstructedMoves.getSize(); i++)
@@ -187,13 +209,13 @@ void test_path_reconstruction()
   }
   std::cout << "\n";
 
-  // Should be: UR (from root->node1) + DLD (from node1->goal) = "URDLD"
-  assert(reconstructedMoves.getSize() == 5 && "Should have 5 total moves");
-  assert(reconstructedMoves[0] == 'U' && "First move should be U");
-  assert(reconstructedMoves[1] == 'R' && "Second move should be R");
-  assert(reconstructedMoves[2] == 'D' && "Third move should be D");
-  assert(reconstructedMoves[3] == 'L' && "Fourth move should be L");
-  assert(reconstructedMoves[4] == 'D' && "Fifth move should be D");
+  // Walk 2 to (3,2), push U, walk L U around the box, push R = "URULUR"
+  const char expected[] = {'U', 'R', 'U', 'L', 'U', 'R'};
+  assert(reconstructedMoves.getSize() == 6 && "Should have 6 total moves");
+  for (int i = 0; i < 6; i++)
+  {
+    assert(reconstructedMoves[i] == expected[i] && "Move sequence mismatch");
+  }
 
   std::cout << "✓ Path reconstruction test completed!\n";
 }
@@ -0,0 +1,131 @@
+#include "../src/DeadlockPatterns.h"
+#include "../src/SokobanHeuristics.h"
+#include <iostream>
+#include <cassert>
+
+// ########
+// #.    .#   Goals in the top corners; boxes are placed per test
+// #      #
+// #      #
+// ########
+static void buildBoard(Board &board)
+{
+  board.initialize(8, 5);
+  for (int col = 0; col < 8; col++)
+  {
+    board.set_wall(0, col);
+    board.set_wall(4, col);
+  }
+  for (int row = 0; row < 5; row++)
+  {
+    board.set_wall(row, 0);
+    board.set_wall(row, 7);
+  }
+  board.set_target(1, 1);
+  board.set_target(1, 6);
+}
+
+void test_learn_frozen_pair()
+{
+  std::cout << "\n=== Testing a learned pair against the wall ===\n";
+
+  Board board;
+  buildBoard(board);
+  SokobanHeuristics heuristics;
+  heuristics.initialize(board);
+  DeadlockPatterns patterns;
+  patterns.initialize(board, heuristics.getDeadSquares());
+
+  // Two boxes side by side on the top wall never move again
+  CellBitset pair;
+  pair.set(1 * 8 + 3);
+  pair.set(1 * 8 + 4);
+  assert(!patterns.matches(pair, 1 * 8 + 3));
+  assert(patterns.learn(pair, 1 * 8 + 3));
+  assert(patterns.getPatternCount() > 0);
+
+  // Found from either box, with an unrelated box elsewhere
+  CellBitset more = pair;
+  more.set(3 * 8 + 5);
+  assert(patterns.matches(more, 1 * 8 + 3));
+  assert(patterns.matches(more, 1 * 8 + 4));
+  assert(patterns.getHits() == 2);
+
+  // Each box alone can still be pushed to a corner goal
+  CellBitset single;
+  single.set(1 * 8 + 3);
+  single.set(3 * 8 + 5);
+  assert(!patterns.matches(single, 1 * 8 + 3));
+  assert(!patterns.learn(single, 1 * 8 + 3));
+
+  std::cout << "✓ Frozen pair test passed!\n";
+}
+
+void test_pattern_escape()
+{
+  std::cout << "\n=== Testing a pattern whose box can leave the block ===\n";
+
+  Board board;
+  buildBoard(board);
+  SokobanHeuristics heuristics;
+  heuristics.initialize(board);
+  DeadlockPatterns patterns;
+  patterns.initialize(board, heuristics.getDeadSquares());
+
+  // Two boxes in open floor: never proven dead, and not retried
+  CellBitset open;
+  open.set(2 * 8 + 3);
+  open.set(2 * 8 + 4);
+  assert(!patterns.learn(open, 2 * 8 + 3));
+  long long proofs = patterns.getProofs();
+  assert(!patterns.learn(open, 2 * 8 + 3));
+  assert(patterns.getProofs() == proofs);
+  assert(patterns.getPatternCount() == 0);
+
+  std::cout << "✓ Escape test passed!\n";
+}
+
+void test_heuristics_consult_patterns()
+{
+  std::cout << "\n=== Testing isDeadlocked with a learned pattern ===\n";
+
+  Board board;
+  buildBoard(board);
+  SokobanHeuristics heuristics;
+  heuristics.initialize(board);
+
+  // The pair was just made by pushing the right box left
+  State pushed(1 * 8 + 5, -1, 0, 0);
+  pushed.addBox(1 * 8 + 3, 0);
+  pushed.addBox(1 * 8 + 4, 0);
+  pushed.setActionFromParent('L');
+
+  // The offline table (make pattern-table) already knows a pair against a
+  // wall; learning stores it all the same
+  assert(heuristics.getDeadlockTable().isLoaded());
+  assert(heuristics.isPatternDeadlocked(pushed));
+  assert(heuristics.learnDeadlock(pushed));
+  assert(heuristics.getPatterns().getPatternCount() > 0);
+  assert(heuristics.isDeadlocked(pushed));
+  assert(heuristics.isPushDeadlocked(pushed));
+
+  // Key pickups move no box and teach nothing
+  State pickup = pushed;
+  pickup.setActionFromParent('K');
+  assert(!heuristics.learnDeadlock(pickup));
+
+  std::cout << "✓ Heuristics pattern test passed!\n";
+}
+
+int main()
+{
+  std::cout << "Testing DeadlockPatterns\n";
+  std::cout << "========================\n";
+
+  test_learn_frozen_pair();
+  test_pattern_escape();
+  test_heuristics_consult_patterns();
+
+  std::cout << "\n🎉 All DeadlockPatterns tests passed!\n";
+  return 0;
+}
@@ -206,6 +206,45 @@ void testCompleteIntegration()
             << ", all " << L << " step hashes unique, wraps correctly" << std::endl;
 }
 
+void testDoorSchedule()
+{
+  std::cout << "\n=== Testing Door Schedule Table ===" << std::endl;
+
+  Array<Door> doors;
+  doors.push_back(Door(1, 2, 1, 0, true));  // cycle = 3
+  doors.push_back(Door(2, 1, 3, 2, false)); // cycle = 4, phased
+
+  Board board;
+  board.initialize(4, 3);
+  board.set_door(0, 1, 1);
+  board.set_door(1, 2, 2);
+  board.set_door(2, 3, 5); // No Door definition for id 5
+  board.computeTimeModuloL(doors);
+
+  int L = board.getTimeModuloL();
+  assert(L == 12);
+
+  // The table must agree with the door cycles at every step
+  for (int t = 0; t < L; t++)
+  {
+    assert(board.is_door_open(1, t) == doors[0].isOpenAtTime(t));
+    assert(board.is_door_open(2, t) == doors[1].isOpenAtTime(t));
+    assert(board.is_open_idx(board.index(0, 1), t) == doors[0].isOpenAtTime(t));
+    assert(board.is_open_idx(board.index(1, 2), t) == doors[1].isOpenAtTime(t));
+
+    // Plain floor is always open, undefined doors always closed
+    assert(board.is_open_idx(board.index(0, 0), t));
+    assert(!board.is_open_idx(board.index(2, 3), t));
+  }
+
+  // Per-cell ids follow walls overwriting doors
+  assert(board.get_door_id_idx(board.index(0, 1)) == 1);
+  board.set_wall(0, 1);
+  assert(board.get_door_id_idx(board.index(0, 1)) == 0);
+
+  std::cout << "✓ Door schedule matches door cycles for all " << L << " steps" << std::endl;
+}
+
 void testMaxSafeLWarning()
 {
   std::cout << "\n=== Testing MAX_SAFE_L Warning ===" << std::endl;
@@ -239,6 +278,7 @@ int main()
     testStateStepModL();
     testZobristTimeHashing();
     testCompleteIntegration();
+    testDoorSchedule();
     testMaxSafeLWarning();
 
     std::cout << "\n🎉 All Door Cycle Modulus L tests passed!" << std::endl;
@@ -247,6 +287,7 @@ int main()
     std::cout << "- Board stores and provides time modulo L" << std::endl;
     std::cout << "- State properly updates step_mod_L with modulo arithmetic" << std::endl;
     std::cout << "- Zobrist hashing includes step_mod_L for unique state hashes" << std::endl;
+    std::cout << "- Precomputed door schedule table" << std::endl;
     std::cout << "- MAX_SAFE_L warning system for large L values" << std::endl;
     std::cout << "- Complete integration between Board, State, and Zobrist" << std::endl;
 
@@ -0,0 +1,133 @@
+#include "../src/OpenList.h"
+#include <iostream>
+#include <cassert>
+#include <random>
+
+void test_basic_ordering(OpenListType type, const char *name)
+{
+  std::cout << "\n=== Testing " << name << " ordering ===\n";
+
+  OpenList *open = OpenList::create(type);
+  assert(open->isEmpty());
+
+  // Push out of order: (f, h, id)
+  open->push(OpenEntry(7, 3, 1));
+  open->push(OpenEntry(5, 4, 2));
+  open->push(OpenEntry(5, 1, 3));
+  open->push(OpenEntry(9, 0, 4));
+  open->push(OpenEntry(5, 2, 5));
+  assert(open->getSize() == 5);
+
+  // Expect f ascending, then h ascending
+  uint32_t expected[] = {3, 5, 2, 1, 4};
+  for (int i = 0; i < 5; i++)
+  {
+    OpenEntry e = open->pop();
+    std::cout << "  popped f=" << e.f << " h=" << e.h << " id=" << e.id << "\n";
+    assert(e.id == expected[i]);
+  }
+  assert(open->isEmpty());
+
+  delete open;
+  std::cout << "✓ " << name << " ordering test passed!\n";
+}
+
+void test_bucket_lifo_ties()
+{
+  std::cout << "\n=== Testing bucket LIFO tie-breaking ===\n";
+
+  BucketOpenList open;
+  open.push(OpenEntry(4, 2, 10));
+  open.push(OpenEntry(4, 2, 11));
+  open.push(OpenEntry(4, 2, 12));
+
+  // Equal (f, h): most recently pushed first
+  assert(open.pop().id == 12);
+  assert(open.pop().id == 11);
+  assert(open.pop().id == 10);
+
+  std::cout << "✓ LIFO tie-breaking test passed!\n";
+}
+
+void test_bucket_overflow_and_rewind()
+{
+  std::cout << "\n=== Testing bucket overflow and cursor rewind ===\n";
+
+  BucketOpenList open;
+  open.push(OpenEntry(999999 + 5, 999999, 1)); // "unreachable" heuristic
+  open.push(OpenEntry(20, 5, 2));
+  assert(open.pop().id == 2);
+
+  // Pushing below the cursor after a pop must still come out first
+  open.push(OpenEntry(30, 1, 3));
+  open.push(OpenEntry(10, 1, 4));
+  assert(open.pop().id == 4);
+  assert(open.pop().id == 3);
+  assert(open.pop().id == 1);
+  assert(open.isEmpty());
+
+  // clear() resets everything
+  open.push(OpenEntry(3, 1, 5));
+  open.clear();
+  assert(open.isEmpty() && open.getSize() == 0);
+
+  std::cout << "✓ Overflow and rewind test passed!\n";
+}
+
+void test_random_against_heap()
+{
+  std::cout << "\n=== Testing bucket queue against binary heap (random workload) ===\n";
+
+  std::mt19937 rng(42);
+  HeapOpenList heap;
+  BucketOpenList bucket;
+
+  // Interleave pushes and pops; (f, h) sequences must match exactly
+  int popped = 0;
+  for (int step = 0; step < 20000; step++)
+  {
+    if (heap.isEmpty() || rng() % 3 != 0)
+    {
+      int h = rng() % 40;
+      int f = h + rng() % 60;
+      OpenEntry e(f, h, step);
+      heap.push(e);
+      bucket.push(e);
+    }
+    else
+    {
+      OpenEntry a = heap.pop();
+      OpenEntry b = bucket.pop();
+      assert(a.f == b.f && a.h == b.h);
+      popped++;
+    }
+    assert(heap.getSize() == bucket.getSize());
+  }
+
+  while (!heap.isEmpty())
+  {
+    OpenEntry a = heap.pop();
+    OpenEntry b = bucket.pop();
+    assert(a.f == b.f && a.h == b.h);
+    popped++;
+  }
+  assert(bucket.isEmpty());
+
+  std::cout << "  compared " << popped << " pops\n";
+  std::cout << "✓ Random workload test passed!\n";
+}
+
+int main()
+{
+  std::cout << "Testing OpenList implementations\n";
+  std::cout << "================================\n";
+
+  test_basic_ordering(OPEN_LIST_BINARY_HEAP, "HeapOpenList");
+  test_basic_ordering(OPEN_LIST_BUCKET, "BucketOpenList");
+  test_bucket_lifo_ties();
+  test_bucket_overflow_and_rewind();
+  test_random_against_heap();
+
+  std::cout << "\n🎉 All OpenList tests passed!\n";
+  return 0;
+}
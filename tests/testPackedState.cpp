@@ -0,0 +1,174 @@
+#include "../src/PackedState.h"
+#include <iostream>
+#include <cassert>
+#include <cstring>
+
+// Level-like initial state: two plain boxes, two locked boxes, three keys
+static State makeInitial()
+{
+  State s(25, -1, 0, 3);
+  s.addBox(40, 0);
+  s.addBox(12, 0);
+  s.addBox(33, 'B');
+  s.addBox(18, 'A');
+  s.addKey(7, 'a');
+  s.addKey(50, 'b');
+  s.addKey(61, 'c');
+  s.canonicalize();
+  return s;
+}
+
+void test_round_trip()
+{
+  std::cout << "\n=== Testing pack/unpack round trip ===\n";
+
+  State initial = makeInitial();
+  StatePacker packer;
+  packer.initialize(initial);
+  std::cout << "  record size: " << packer.getRecordSize() << " bytes\n";
+  assert(packer.getRecordSize() < 32);
+
+  uint8_t bytes[64];
+  packer.pack(initial, bytes);
+
+  State restored;
+  packer.unpack(bytes, restored);
+  assert(restored.equals(initial));
+
+  // A later state: key 'a' picked up and used on box A, key 'c' held
+  State later = initial;
+  later.removeKey(0);
+  later.getBox(initial.findBoxAt(18)).id = 0;
+  later.moveBox(initial.findBoxAt(18), 19);
+  later.removeKey(1);
+  later.setKeyHeld('c' - 'a');
+  later.setPlayerPos(61);
+  later.setStepModL(1);
+  later.canonicalize();
+
+  packer.pack(later, bytes);
+  packer.unpack(bytes, restored);
+  assert(restored.equals(later));
+  assert(restored.getKeyHeld() == 2);
+  assert(restored.getKeyCount() == 1 && restored.getKeyPos(0) == 50);
+  assert(restored.getBox(restored.getBoxCount() - 1).id == 'B');
+
+  std::cout << "✓ Round trip test passed!\n";
+}
+
+void test_canonical_bytes()
+{
+  std::cout << "\n=== Testing equal states pack to equal bytes ===\n";
+
+  State initial = makeInitial();
+  StatePacker packer;
+  packer.initialize(initial);
+  int size = packer.getRecordSize();
+
+  // Same boxes added in another order; energy differs (not part of the state)
+  State other(25, -1, 99, 3);
+  other.addBox(18, 'A');
+  other.addBox(33, 'B');
+  other.addBox(12, 0);
+  other.addBox(40, 0);
+  other.addKey(7, 'a');
+  other.addKey(50, 'b');
+  other.addKey(61, 'c');
+  other.canonicalize();
+
+  uint8_t a[64];
+  uint8_t b[64];
+  packer.pack(initial, a);
+  packer.pack(other, b);
+  assert(memcmp(a, b, size) == 0);
+
+  // Any search-relevant difference changes the bytes
+  other.setStepModL(4);
+  packer.pack(other, b);
+  assert(memcmp(a, b, size) != 0);
+
+  std::cout << "✓ Canonical bytes test passed!\n";
+}
+
+void test_normalized_player()
+{
+  std::cout << "\n=== Testing normalized player layout ===\n";
+
+  State initial = makeInitial();
+  StatePacker packer;
+  packer.initialize(initial, true);
+  assert(packer.getRecordSize() == packer.getKeySize() + 2);
+
+  // Two states whose players stand in the same area share the key bytes
+  State a = initial;
+  a.setCanonicalPlayerPos(9);
+  State b = initial;
+  b.setPlayerPos(30);
+  b.setCanonicalPlayerPos(9);
+  assert(a.equals(b));
+
+  uint8_t bytesA[64];
+  uint8_t bytesB[64];
+  packer.pack(a, bytesA);
+  packer.pack(b, bytesB);
+  assert(memcmp(bytesA, bytesB, packer.getKeySize()) == 0);
+  assert(memcmp(bytesA, bytesB, packer.getRecordSize()) != 0);
+
+  // The true position survives the round trip
+  State restored;
+  packer.unpack(bytesB, restored);
+  assert(restored.getPlayerPos() == 30 && restored.getCanonicalPlayerPos() == 9);
+
+  std::cout << "✓ Normalized player test passed!\n";
+}
+
+void test_pool()
+{
+  std::cout << "\n=== Testing PackedStatePool ===\n";
+
+  State initial = makeInitial();
+  StatePacker packer;
+  packer.initialize(initial);
+
+  PackedStatePool pool;
+  pool.reset(packer.getRecordSize());
+
+  // Enough records to span several chunks
+  const int count = 10000;
+  for (int i = 0; i < count; i++)
+  {
+    State s = initial;
+    s.setPlayerPos(i % 64);
+    s.setStepModL(i % 5);
+    uint32_t id = pool.allocate();
+    assert(id == static_cast<uint32_t>(i));
+    packer.pack(s, pool.get(id));
+  }
+  assert(pool.getSize() == static_cast<uint32_t>(count));
+
+  for (int i = 0; i < count; i++)
+  {
+    State s;
+    packer.unpack(pool.get(i), s);
+    assert(s.getPlayerPos() == i % 64 && s.getStepModL() == i % 5);
+  }
+
+  pool.reset(packer.getRecordSize());
+  assert(pool.getSize() == 0);
+
+  std::cout << "✓ Pool test passed!\n";
+}
+
+int main()
+{
+  std::cout << "Testing PackedState\n";
+  std::cout << "===================\n";
+
+  test_round_trip();
+  test_canonical_bytes();
+  test_normalized_player();
+  test_pool();
+
+  std::cout << "\n🎉 All PackedState tests passed!\n";
+  return 0;
+}
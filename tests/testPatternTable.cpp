@@ -0,0 +1,158 @@
+#include "../src/PatternTable.h"
+#include "../src/SokobanHeuristics.h"
+#include <iostream>
+#include <fstream>
+#include <cassert>
+
+static const char *SCRATCH_PATH = "bin/testPatternTable.bin";
+
+void test_generated_blocks()
+{
+  std::cout << "\n=== Testing generated 3x3 blocks ===\n";
+
+  PatternTable table;
+  table.generate(PatternTable::DEFAULT_MAX_BOXES);
+  assert(table.isLoaded());
+
+  // A box in a corner is dead unless it sits on a goal
+  assert(table.isDeadCode(PatternTable::encode("####$ #  ")));
+  assert(!table.isDeadCode(PatternTable::encode("####* #  ")));
+
+  // Two boxes side by side against a wall
+  assert(table.isDeadCode(PatternTable::encode("###$$    ")));
+  assert(!table.isDeadCode(PatternTable::encode("###**    ")));
+  assert(!table.isDeadCode(PatternTable::encode("###$ $   ")));
+
+  // A square of four boxes in open floor
+  assert(table.isDeadCode(PatternTable::encode("$$ $$    ")));
+  assert(!table.isDeadCode(PatternTable::encode("$$ $     ")));
+
+  // Adding a box to a dead block keeps it dead
+  assert(table.isDeadCode(PatternTable::encode("###$$ $  ")));
+
+  // A lone box in open floor, or next to a single wall
+  assert(!table.isDeadCode(PatternTable::encode("    $    ")));
+  assert(!table.isDeadCode(PatternTable::encode("   #$    ")));
+
+  std::cout << "✓ Generated blocks test passed!\n";
+}
+
+void test_save_and_load()
+{
+  std::cout << "\n=== Testing table save and load ===\n";
+
+  PatternTable table;
+  table.generate(2);
+  assert(table.save(SCRATCH_PATH));
+
+  PatternTable loaded;
+  assert(loaded.load(SCRATCH_PATH));
+  assert(loaded.getMaxBoxes() == 2);
+  assert(loaded.getDeadCount() == table.getDeadCount());
+  for (int code = 0; code < PatternTable::CODE_COUNT; code++)
+  {
+    assert(loaded.isDeadCode(code) == table.isDeadCode(code));
+  }
+
+  // Missing and truncated files leave the table empty
+  assert(!loaded.load("bin/no-such-table.bin"));
+  assert(!loaded.isLoaded());
+  {
+    std::ofstream truncated(SCRATCH_PATH, std::ios::binary);
+    truncated.write("SKDT\x01\x03\x05\x02", 8);
+  }
+  assert(!loaded.load(SCRATCH_PATH));
+  assert(!loaded.isDeadCode(PatternTable::encode("####$ #  ")));
+
+  std::cout << "✓ Save and load test passed!\n";
+}
+
+void test_shipped_table()
+{
+  std::cout << "\n=== Testing the generated table file ===\n";
+
+  // The file from make pattern-table matches a fresh generation
+  PatternTable shipped;
+  assert(shipped.load(PatternTable::DEFAULT_PATH));
+  PatternTable fresh;
+  fresh.generate(shipped.getMaxBoxes());
+  assert(shipped.getDeadCount() == fresh.getDeadCount());
+  for (int code = 0; code < PatternTable::CODE_COUNT; code++)
+  {
+    assert(shipped.isDeadCode(code) == fresh.isDeadCode(code));
+  }
+
+  std::cout << "✓ Table file test passed!\n";
+}
+
+void test_board_lookup()
+{
+  std::cout << "\n=== Testing table lookups on a board ===\n";
+
+  // #######
+  // #.   .#
+  // #     #
+  // #     #
+  // #######
+  Board board;
+  board.initialize(7, 5);
+  for (int col = 0; col < 7; col++)
+  {
+    board.set_wall(0, col);
+    board.set_wall(4, col);
+  }
+  for (int row = 0; row < 5; row++)
+  {
+    board.set_wall(row, 0);
+    board.set_wall(row, 6);
+  }
+  board.set_target(1, 1);
+  board.set_target(1, 5);
+
+  PatternTable table;
+  table.generate(PatternTable::DEFAULT_MAX_BOXES);
+  table.bind(board);
+
+  // Pair on the top wall, found from either box
+  CellBitset boxes;
+  boxes.set(1 * 7 + 2);
+  boxes.set(1 * 7 + 3);
+  assert(table.matches(boxes, 1 * 7 + 2));
+  assert(table.matches(boxes, 1 * 7 + 3));
+
+  // Pair in the middle row can still be split up
+  CellBitset middle;
+  middle.set(2 * 7 + 2);
+  middle.set(2 * 7 + 3);
+  assert(!table.matches(middle, 2 * 7 + 2));
+
+  // A box on a corner goal is fine
+  CellBitset solved;
+  solved.set(1 * 7 + 1);
+  assert(!table.matches(solved, 1 * 7 + 1));
+
+  // The heuristics prune the push that made the pair
+  SokobanHeuristics heuristics;
+  heuristics.initialize(board);
+  State pushed(1 * 7 + 4, -1, 0, 0);
+  pushed.addBox(1 * 7 + 2, 0);
+  pushed.addBox(1 * 7 + 3, 0);
+  pushed.setActionFromParent('L');
+  assert(heuristics.isPushDeadlocked(pushed));
+
+  std::cout << "✓ Board lookup test passed!\n";
+}
+
+int main()
+{
+  std::cout << "Testing PatternTable\n";
+  std::cout << "====================\n";
+
+  test_generated_blocks();
+  test_save_and_load();
+  test_shipped_table();
+  test_board_lookup();
+
+  std::cout << "\n🎉 All PatternTable tests passed!\n";
+  return 0;
+}
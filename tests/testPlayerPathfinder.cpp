@@ -253,6 +253,85 @@ void test_unreachable_positions()
   std::cout << "✓ Unreachable position tests passed!\n";
 }
 
+void test_flood_fill()
+{
+  std::cout << "\n=== Testing Bit-Parallel Flood Fill ===\n";
+
+  // 7x5 board, walls and two boxes split it into regions:
+  // . . # . . . .
+  // . . # . B . .
+  // . . . . # # .
+  // # # # . B . .
+  // . . # . . . .
+  Board board;
+  board.initialize(7, 5);
+  Array<Door> doors;
+  board.set_wall(0, 2);
+  board.set_wall(1, 2);
+  board.set_wall(2, 4);
+  board.set_wall(2, 5);
+  board.set_wall(3, 0);
+  board.set_wall(3, 1);
+  board.set_wall(3, 2);
+  board.set_wall(4, 2);
+  board.computeTimeModuloL(doors);
+
+  PlayerPathfinder pathfinder;
+  pathfinder.initialize(board, doors);
+  assert(pathfinder.hasBitParallelFill());
+
+  Array<int> boxes;
+  boxes.push_back(board.index(1, 4));
+  boxes.push_back(board.index(3, 4));
+  pathfinder.setBlockedPositions(boxes);
+
+  // Reachability must agree with a full BFS from every start cell
+  int cells = board.get_width() * board.get_height();
+  for (int start = 0; start < cells; start++)
+  {
+    pathfinder.findPaths(start, 0);
+    Array<int> dist;
+    for (int pos = 0; pos < cells; pos++)
+    {
+      dist.push_back(pathfinder.getDistance(pos));
+    }
+
+    pathfinder.floodFill(start);
+    CellBitset targets;
+    int targetCount = 0;
+    for (int pos = 0; pos < cells; pos++)
+    {
+      assert(pathfinder.isReachable(pos) == (dist[pos] != -1));
+      if (pos % 3 == 0 && dist[pos] != -1)
+      {
+        targets.set(pos);
+        targetCount++;
+      }
+    }
+
+    // Early-stopping BFS still gives exact distances for its targets
+    pathfinder.findPathsTo(start, 0, targets, targetCount);
+    for (int pos = 0; pos < cells; pos++)
+    {
+      if (targets.test(pos))
+        assert(pathfinder.getDistance(pos) == dist[pos]);
+    }
+  }
+
+  // Doors disable the fast path
+  Board doorBoard;
+  doorBoard.initialize(3, 3);
+  Array<Door> someDoors;
+  someDoors.push_back(Door(1, 1, 1, 0, true));
+  doorBoard.set_door(1, 1, 1);
+  doorBoard.computeTimeModuloL(someDoors);
+  PlayerPathfinder doorPathfinder;
+  doorPathfinder.initialize(doorBoard, someDoors);
+  assert(!doorPathfinder.hasBitParallelFill());
+
+  std::cout << "✓ Flood fill tests passed!\n";
+}
+
 int main()
 {
   std::cout << "=== PlayerPathfinder Test Suite ===\n";
@@ -262,6 +341,7 @@ int main()
   test_grid_with_door();
   test_complex_door_timing();
   test_unreachable_positions();
+  test_flood_fill();
 
   std::cout << "\n🎉 All PlayerPathfinder tests passed! 🎉\n";
   return 0;
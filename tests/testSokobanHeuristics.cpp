@@ -296,6 +296,61 @@ void test_multiple_boxes_heuristic()
   std::cout << "✓ Multiple boxes heuristic test passed!" << std::endl;
 }
 
+void test_push_distances()
+{
+  std::cout << "\n=== Testing Push Distance Tables ===\n";
+
+  // Layout (goal at (1,1)):
+  // #######
+  // #.    #
+  // #     #
+  // #######
+  Board board;
+  board.initialize(7, 4);
+  for (int c = 0; c < 7; c++)
+  {
+    board.set_wall(0, c);
+    board.set_wall(3, c);
+  }
+  for (int r = 0; r < 4; r++)
+  {
+    board.set_wall(r, 0);
+    board.set_wall(r, 6);
+  }
+  board.set_target(1, 1);
+
+  SokobanHeuristics heuristics;
+  heuristics.initialize(board);
+  const PrecomputedDistances &distances = heuristics.getPrecomputedDistances();
+
+  // Along the top wall the box can be pushed left: plain grid distance
+  assert(distances.getDistance(0, 1 * 7 + 3) == 2);
+  assert(distances.getDistance(0, 1 * 7 + 2) == 1);
+
+  // Nothing can push a box up off the bottom wall, or out of the far corner
+  assert(distances.getDistance(0, 2 * 7 + 3) == INT_MAX);
+  assert(distances.getDistance(0, 2 * 7 + 1) == INT_MAX);
+  assert(distances.getDistance(0, 1 * 7 + 5) == INT_MAX);
+
+  // The heuristic follows the tighter table
+  Zobrist zobrist;
+  zobrist.init(28, 10, 5, 1);
+  State on_wall(1 * 7 + 4, -1, 0, 0);
+  on_wall.addBox(2 * 7 + 3, 0);
+  on_wall.recompute_hash(zobrist);
+  assert(heuristics.heuristic(on_wall) == 999999);
+
+  // The same cells form the dead square map used by stage 1-2 checks
+  assert(heuristics.isDeadSquare(2 * 7 + 3));
+  assert(heuristics.isDeadSquare(1 * 7 + 5));
+  assert(!heuristics.isDeadSquare(1 * 7 + 3));
+  assert(!heuristics.isDeadSquare(1 * 7 + 1)); // Goal
+  assert(heuristics.isWallDeadlocked(on_wall));
+  assert(heuristics.isDeadlocked(on_wall));
+
+  std::cout << "✓ Push distance test passed!" << std::endl;
+}
+
 int main()
 {
   std::cout << "Testing Sokoban Heuristics and Deadlock Detection" << std::endl;
@@ -309,10 +364,11 @@ int main()
     test_real_corner_deadlock();
     test_heuristic_properties();
     test_multiple_boxes_heuristic();
+    test_push_distances();
 
     std::cout << "\n🎉 All heuristics tests passed successfully!" << std::endl;
     std::cout << "\nSokoban heuristics implementation is working correctly:" << std::endl;
-    std::cout << "- BFS distance precomputation from all goals" << std::endl;
+    std::cout << "- Push distance precomputation from all goals" << std::endl;
     std::cout << "- Admissible heuristic function (sum of min distances)" << std::endl;
     std::cout << "- Corner deadlock detection (Stage 1)" << std::endl;
     std::cout << "- Proper handling of multiple boxes and goals" << std::endl;
@@ -5,6 +5,7 @@
 #include "../src/Meta.h"
 #include "../src/Zobrist.h"
 #include "../src/ConfigParser.h"
+#include "../src/Simulation.h"
 #include <iostream>
 #include <cassert>
 
@@ -168,6 +169,44 @@ void test_solver_initialization()
   std::cout << "✓ Solver initialization test completed!\n";
 }
 
+void test_player_normalization()
+{
+  std::cout << "\n=== Testing Player Normalization ===\n";
+
+  // Door-free level with an open room
+  Meta meta;
+  Board board;
+  Array<Door> doors;
+  InitialDynamicState init;
+  ConfigParser parser;
+  assert(parser.parse("configs/Easy-5.txt", meta, board, doors, init));
+
+  Zobrist zobrist;
+  zobrist.init(board.get_width() * board.get_height(), 26, 26, board.getTimeModuloL());
+
+  SolverStats plainStats;
+  SolverStats normStats;
+  for (int pass = 0; pass < 2; pass++)
+  {
+    SolverAStar solver(board, doors, meta, zobrist);
+    solver.setNormalizePlayer(pass == 1);
+
+    Array<char> moves;
+    SolverStats &stats = pass == 1 ? normStats : plainStats;
+    assert(solver.solve(init, moves, stats));
+
+    // Moves are still walked from the true player position
+    DynamicState ds(init);
+    assert(Simulation::simulateMoves(board, ds, moves, doors, meta) && ds.isWin(board));
+  }
+
+  std::cout << "  Expanded without/with normalization: " << plainStats.nodesExpanded
+            << " / " << normStats.nodesExpanded << "\n";
+  assert(normStats.nodesExpanded < plainStats.nodesExpanded);
+
+  std::cout << "✓ Player normalization test completed!\n";
+}
+
 int main()
 {
   std::cout << "Testing Sokoban A* Solver\n";
@@ -178,6 +217,7 @@ int main()
     test_solver_initialization();
     test_simple_solver();
     test_solver_stats();
+    test_player_normalization();
 
     std::cout << "\n🎉 All A* Solver tests completed successfully!\n";
     std::cout << "\nA* Solver implementation includes:\n";
@@ -295,6 +295,35 @@ void testBoxFinding()
   std::cout << "✓ Box removal works correctly" << std::endl;
 }
 
+void testBoxOccupancy()
+{
+  std::cout << "\n=== Testing Box Occupancy Bitset ===" << std::endl;
+
+  State state;
+  state.addBox(3, 0);
+  state.addBox(70, 'A');
+  state.addBox(300, 0); // Beyond the inline bitset words
+  assert(state.hasBoxAt(3) && state.hasBoxAt(70) && state.hasBoxAt(300));
+  assert(!state.hasBoxAt(4) && !state.hasBoxAt(299) && !state.hasBoxAt(5000));
+
+  // Moving a box updates both cells
+  state.moveBox(0, 4);
+  assert(!state.hasBoxAt(3) && state.hasBoxAt(4));
+  assert(state.getBox(0).pos == 4);
+
+  // Copies carry their own bitset
+  State copy = state;
+  copy.moveBox(1, 71);
+  assert(copy.hasBoxAt(71) && !copy.hasBoxAt(70));
+  assert(state.hasBoxAt(70) && !state.hasBoxAt(71));
+
+  // Removal clears the cell
+  state.removeBox(2);
+  assert(!state.hasBoxAt(300));
+
+  std::cout << "✓ Box occupancy stays in sync with box moves" << std::endl;
+}
+
 void testWithRealConfig()
 {
   std::cout << "\n=== Testing with Real Configuration ===" << std::endl;
@@ -336,6 +365,7 @@ int main()
     testStateHashing();
     testHashCollisionDetection();
     testBoxFinding();
+    testBoxOccupancy();
     testWithRealConfig();
 
     std::cout << "\n🎉 All tests passed successfully!" << std::endl;
@@ -285,6 +285,42 @@ void test_energy_limit()
   std::cout << "✓ Energy limit test passed!\n";
 }
 
+void test_dead_square_pushes()
+{
+  std::cout << "\n=== Testing Pushes Onto Dead Squares ===\n";
+
+  // Same 3x3 open board; the cell right of the box is marked dead
+  Board board;
+  board.initialize(3, 3);
+  Array<Door> doors;
+  board.computeTimeModuloL(doors);
+  Meta meta("test", 3, 3, 100, 1, 5);
+
+  Zobrist zobrist;
+  zobrist.init(9, 10, 5, 1);
+
+  State initial_state(0, -1, 0, 0);
+  initial_state.addBox(4, 0);
+  initial_state.recompute_hash(zobrist);
+
+  PlayerPathfinder pathfinder;
+  pathfinder.initialize(board, doors);
+  Array<State> all = generateSuccessors(initial_state, board, doors, meta, pathfinder, &zobrist);
+
+  CellBitset dead;
+  dead.set(5);
+  Array<State> pruned = generateSuccessors(initial_state, board, doors, meta, pathfinder, &zobrist, &dead);
+
+  std::cout << "Successors: " << all.getSize() << " without, " << pruned.getSize() << " with dead squares\n";
+  assert(pruned.getSize() == all.getSize() - 1);
+  for (int i = 0; i < pruned.getSize(); i++)
+  {
+    assert(pruned[i].getBox(0).pos != 5);
+  }
+
+  std::cout << "✓ Dead square push test passed!\n";
+}
+
 int main()
 {
   std::cout << "=== SuccessorGenerator Test Suite ===\n";
@@ -295,6 +331,7 @@ int main()
   test_door_timing();
   test_locked_box();
   test_energy_limit();
+  test_dead_square_pushes();
 
   std::cout << "\n🎉 All SuccessorGenerator tests passed! 🎉\n";
   return 0;
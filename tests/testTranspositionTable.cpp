@@ -0,0 +1,139 @@
+#include "../src/TranspositionTable.h"
+#include "../src/PackedState.h"
+#include <iostream>
+#include <cassert>
+
+// One-box layout shared by every test state
+static StatePacker makePacker()
+{
+  State layout(0, -1, 0, 0);
+  layout.addBox(0, 0);
+  StatePacker packer;
+  packer.initialize(layout);
+  return packer;
+}
+
+// Pack a one-box state into a new pool record and return its id
+static uint32_t addNode(PackedStatePool &pool, const StatePacker &packer, int playerPos, int boxPos)
+{
+  State s(playerPos, -1, 0, 0);
+  s.addBox(boxPos, 0);
+  uint32_t id = pool.allocate();
+  packer.pack(s, pool.get(id));
+  return id;
+}
+
+void test_insert_and_find()
+{
+  std::cout << "\n=== Testing insert and find ===\n";
+
+  StatePacker packer = makePacker();
+  PackedStatePool pool;
+  pool.reset(packer.getRecordSize());
+  TranspositionTable table(pool);
+  assert(table.isEmpty());
+
+  uint64_t hash = 0x1234;
+  uint32_t a = addNode(pool, packer, 10, 20);
+  assert(table.update(a, hash, 5));
+  assert(table.getSize() == 1);
+
+  uint32_t id;
+  int g;
+  assert(table.find(hash, pool.get(a), id, g));
+  assert(id == a && g == 5);
+
+  // Same state reached again: only a cheaper path replaces the entry
+  uint32_t b = addNode(pool, packer, 10, 20);
+  assert(!table.update(b, hash, 5));
+  assert(!table.update(b, hash, 7));
+  assert(table.find(hash, pool.get(b), id, g) && id == a && g == 5);
+
+  uint32_t c = addNode(pool, packer, 10, 20);
+  assert(table.update(c, hash, 3));
+  assert(table.find(hash, pool.get(a), id, g) && id == c && g == 3);
+  assert(table.getSize() == 1);
+
+  std::cout << "✓ Insert and find test passed!\n";
+}
+
+void test_hash_collision()
+{
+  std::cout << "\n=== Testing hash collisions are verified ===\n";
+
+  StatePacker packer = makePacker();
+  PackedStatePool pool;
+  pool.reset(packer.getRecordSize());
+  TranspositionTable table(pool);
+
+  // Two different states forced onto the same hash
+  uint64_t hash = 0xABCD;
+  uint32_t a = addNode(pool, packer, 10, 20);
+  uint32_t b = addNode(pool, packer, 11, 21);
+
+  assert(table.update(a, hash, 4));
+
+  // The colliding state must not be mistaken for the stored one
+  uint32_t id;
+  int g;
+  assert(!table.find(hash, pool.get(b), id, g));
+  assert(table.update(b, hash, 9));
+  assert(table.getSize() == 2);
+
+  assert(table.find(hash, pool.get(a), id, g) && id == a && g == 4);
+  assert(table.find(hash, pool.get(b), id, g) && id == b && g == 9);
+
+  std::cout << "✓ Hash collision test passed!\n";
+}
+
+void test_resize()
+{
+  std::cout << "\n=== Testing load-factor resize ===\n";
+
+  StatePacker packer = makePacker();
+  PackedStatePool pool;
+  pool.reset(packer.getRecordSize());
+  TranspositionTable table(pool);
+  int initialCapacity = table.getCapacity();
+
+  // Many states with clustered hashes to exercise probing across growth
+  const int count = 20000;
+  for (int i = 0; i < count; i++)
+  {
+    uint32_t id = addNode(pool, packer, i, i + 1);
+    assert(table.update(id, static_cast<uint64_t>(i / 3) * 0x9E3779B97F4A7C15ULL, i));
+  }
+  assert(table.getSize() == count);
+  assert(table.getCapacity() > initialCapacity);
+  assert(table.getSize() * 4 <= table.getCapacity() * 3);
+  std::cout << "  capacity grew from " << initialCapacity << " to " << table.getCapacity() << "\n";
+
+  for (int i = 0; i < count; i++)
+  {
+    uint32_t id;
+    int g;
+    assert(table.find(static_cast<uint64_t>(i / 3) * 0x9E3779B97F4A7C15ULL, pool.get(i), id, g));
+    assert(id == static_cast<uint32_t>(i) && g == i);
+  }
+
+  table.clear();
+  assert(table.isEmpty());
+  uint32_t id;
+  int g;
+  assert(!table.find(0, pool.get(0), id, g));
+
+  std::cout << "✓ Resize test passed!\n";
+}
+
+int main()
+{
+  std::cout << "Testing TranspositionTable\n";
+  std::cout << "==========================\n";
+
+  test_insert_and_find();
+  test_hash_collision();
+  test_resize();
+
+  std::cout << "\n🎉 All TranspositionTable tests passed!\n";
+  return 0;
+}